@@ -0,0 +1,75 @@
+#include "animacao.h"
+#include "neopixel_driver.h"
+#if NEOPIXEL_CAMADAS
+#include "tarefa4_controla_neopixel.h" // CAMADA_TENDENCIA
+#endif
+
+static npAnimacao_t anim_corrente;
+static bool anim_ativa = false;
+
+void npAnimIniciar(npAnimacao_t *a, npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    a->gerador = gerador;
+    a->r = r;
+    a->g = g;
+    a->b = b;
+    a->delay_ms = delay_ms;
+    a->quadro = 0;
+    a->proximo = get_absolute_time();
+}
+
+// Gera o próximo quadro em leds[] e informa quando o seguinte será devido.
+// O prazo avança a partir do anterior, sem acumular o atraso do despacho.
+bool npAnimStep(npAnimacao_t *a, absolute_time_t *devido) {
+    if (!a->gerador(a)) {
+        return false;
+    }
+    a->quadro++;
+    a->proximo = delayed_by_ms(a->proximo, a->delay_ms);
+    if (devido) {
+        *devido = a->proximo;
+    }
+    return true;
+}
+
+// Envia leds[] pelo mesmo caminho das tarefas 4/5
+static void npAnimEnviar(void) {
+#if NEOPIXEL_CAMADAS
+    npLayerSetFrame(CAMADA_TENDENCIA, leds);
+    npComposeWrite();
+#else
+    npWrite();
+#endif
+}
+
+void npAnimTocar(npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimIniciar(&anim_corrente, gerador, r, g, b, delay_ms);
+    anim_ativa = true;
+}
+
+bool npAnimAtiva(void) {
+    return anim_ativa;
+}
+
+// Tarefa periódica: no máximo um quadro por chamada, só quando ele é devido.
+// O último quadro permanece na matriz ao término.
+void npAnimTarefa(void) {
+    if (!anim_ativa || !time_reached(anim_corrente.proximo)) {
+        return;
+    }
+    if (npAnimStep(&anim_corrente, NULL)) {
+        npAnimEnviar();
+    } else {
+        anim_ativa = false;
+    }
+}
+
+void npAnimBloqueante(npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimacao_t a;
+    absolute_time_t devido;
+
+    npAnimIniciar(&a, gerador, r, g, b, delay_ms);
+    while (npAnimStep(&a, &devido)) {
+        npWrite();
+        sleep_until(devido);
+    }
+}
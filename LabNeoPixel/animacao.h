@@ -0,0 +1,34 @@
+#ifndef ANIMACAO_H
+#define ANIMACAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+typedef struct npAnimacao npAnimacao_t;
+
+// Gerador de quadros: desenha o quadro 'a->quadro' em leds[] (do zero) e
+// retorna false quando a animação não tem mais quadros
+typedef bool (*npGerador_t)(const npAnimacao_t *a);
+
+// Estado de uma animação em andamento
+struct npAnimacao {
+    npGerador_t gerador;
+    uint8_t r, g, b;
+    uint16_t delay_ms;       // Intervalo entre quadros
+    uint16_t quadro;         // Próximo quadro a gerar
+    absolute_time_t proximo; // Instante em que o próximo quadro é devido
+};
+
+void npAnimIniciar(npAnimacao_t *a, npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+bool npAnimStep(npAnimacao_t *a, absolute_time_t *devido);
+
+// Animação corrente, avançada por uma tarefa periódica do escalonador
+void npAnimTocar(npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+bool npAnimAtiva(void);
+void npAnimTarefa(void);
+
+// Executa uma animação inteira bloqueando (uso fora do escalonador)
+void npAnimBloqueante(npGerador_t gerador, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+
+#endif
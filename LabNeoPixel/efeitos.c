@@ -5,161 +5,151 @@
 #include <stdlib.h> 
 
 
+// Espiral da matriz 5x5 (em matrizes maiores ela ocupa o canto superior esquerdo)
+static const uint8_t ordem_espiral[][2] = {
+    {0,0},{1,0},{2,0},{3,0},{4,0},
+    {4,1},{4,2},{4,3},{4,4},
+    {3,4},{2,4},{1,4},{0,4},
+    {0,3},{0,2},{0,1},
+    {1,1},{2,1},{3,1},
+    {3,2},{3,3},
+    {2,3},{1,3},
+    {1,2},{2,2}
+};
+#define N_ESPIRAL (sizeof(ordem_espiral) / sizeof(ordem_espiral[0]))
+
 // Acende todos os LEDs de uma linha
 void acenderFileira(uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
-    for (uint x = 0; x < NUM_COLUNAS; x++) {
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
-    }
+    npSetFileira(y, r, g, b);
     npWrite();
 }
 
 // Acende todos os LEDs de uma coluna
 void acenderColuna(uint8_t x, uint8_t r, uint8_t g, uint8_t b) {
-    for (uint y = 0; y < NUM_LINHAS; y++) {
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
-    }
+    npSetColuna(x, r, g, b);
     npWrite();
 }
 
-// Preenche a matriz em espiral do canto superior esquerdo ao centro
-void efeitoEspiral(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    const uint8_t ordem_espiral[25][2] = {
-        {0,0},{1,0},{2,0},{3,0},{4,0},
-        {4,1},{4,2},{4,3},{4,4},
-        {3,4},{2,4},{1,4},{0,4},
-        {0,3},{0,2},{0,1},
-        {1,1},{2,1},{3,1},
-        {3,2},{3,3},
-        {2,3},{1,3},
-        {1,2},{2,2}
-    };
+// === Geradores de quadros (um quadro por chamada, sem espera) ===
 
+// Quadro i: os i + 1 primeiros LEDs da espiral, do canto ao centro
+bool quadroEspiral(const npAnimacao_t *a) {
+    if (a->quadro >= N_ESPIRAL) return false;
     npClear();
-    for (uint i = 0; i < 25; ++i) {
-        uint x = ordem_espiral[i][0];
-        uint y = ordem_espiral[i][1];
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
-        npWrite();
-        sleep_ms(delay_ms);
+    for (uint i = 0; i <= a->quadro; ++i) {
+        npSetXY(ordem_espiral[i][0], ordem_espiral[i][1], a->r, a->g, a->b);
     }
+    return true;
 }
 
-// Efeito de onda vertical com brilho suavizado por linha
-void efeitoOndaVertical(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int fase = 0; fase < NUM_LINHAS + 3; ++fase) {
-        npClear();
-        for (int y = 0; y < NUM_LINHAS; ++y) {
-            float intensidade = 1.0f - 0.25f * abs(fase - y);
-            if (intensidade < 0) intensidade = 0;
-
-            for (int x = 0; x < NUM_COLUNAS; ++x) {
-                uint index = getLEDIndex(x, y);
-                npSetLED(index, r * intensidade, g * intensidade, b * intensidade);
-            }
-        }
-        npWrite();
-        sleep_ms(delay_ms);
+// Mesma espiral percorrida do centro para o canto
+bool quadroEspiralInversa(const npAnimacao_t *a) {
+    if (a->quadro >= N_ESPIRAL) return false;
+    npClear();
+    for (uint i = 0; i <= a->quadro; ++i) {
+        uint k = N_ESPIRAL - 1 - i;
+        npSetXY(ordem_espiral[k][0], ordem_espiral[k][1], a->r, a->g, a->b);
     }
+    return true;
 }
 
-// Preenche a matriz em espiral do canto superior esquerdo ao centro, inversa.
-void efeitoEspiralInversa(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    const uint8_t ordem_espiral[25][2] = {
-        {2,2},{1,2},{1,3},{2,3},{3,3},
-        {3,2},{3,1},{2,1},{1,1},
-        {0,1},{0,2},{0,3},{0,4},
-        {1,4},{2,4},{3,4},
-        {4,4},{4,3},{4,2},
-        {4,1},{4,0},
-        {3,0},{2,0},
-        {1,0},{0,0}
-    };
-
+// Onda vertical com brilho suavizado por linha
+bool quadroOndaVertical(const npAnimacao_t *a) {
+    int fase = a->quadro;
+    if (fase >= NUM_LINHAS + 3) return false;
     npClear();
-    for (uint i = 0; i < 25; ++i) {
-        uint x = ordem_espiral[i][0];
-        uint y = ordem_espiral[i][1];
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
-        npWrite();
-        sleep_ms(delay_ms);
+    for (int y = 0; y < NUM_LINHAS; ++y) {
+        // 100%, 75%, 50%, 25% conforme a distância até a crista
+        int distancia = abs(fase - y);
+        uint8_t intensidade = distancia < 4 ? NP_BRILHO_MAX - 64 * distancia : 0;
+        npSetFileira(y, npScale8(a->r, intensidade), npScale8(a->g, intensidade), npScale8(a->b, intensidade));
     }
+    return true;
 }
 
-
-//Onda com efeito vertical brilho
-void efeitoOndaVerticalBrilho(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t passo = 0; passo < NUM_LINHAS; ++passo) {
-        npClear();
-
-        for (uint8_t y = 0; y <= passo; ++y) {
-            // Brilho progressivo proporcional à linha atual
-            float brilho = ((float)(y + 1)) / NUM_LINHAS;
-
-            for (uint8_t x = 0; x < NUM_COLUNAS; ++x) {
-                uint index = getLEDIndex(x, y);
-                npSetLED(index, r * brilho, g * brilho, b * brilho);
-            }
-        }
-
-        npWrite();
-        sleep_ms(delay_ms);
+// Linhas acendendo de baixo para cima com brilho progressivo
+bool quadroOndaVerticalBrilho(const npAnimacao_t *a) {
+    uint passo = a->quadro;
+    if (passo >= NUM_LINHAS) return false;
+    npClear();
+    for (uint8_t y = 0; y <= passo; ++y) {
+        // Brilho progressivo proporcional à linha atual
+        uint8_t brilho = (y + 1) * NP_BRILHO_MAX / NUM_LINHAS;
+        npSetFileira(y, npScale8(a->r, brilho), npScale8(a->g, brilho), npScale8(a->b, brilho));
     }
+    return true;
 }
 
+bool quadroFileirasColoridas(const npAnimacao_t *a) {
+    uint8_t y = a->quadro;
+    if (y >= NUM_LINHAS) return false;
+    uint8_t brilho = (y + 1) * NP_BRILHO_MAX / NUM_LINHAS;
+    npClear();
+    npSetFileira(y, npScale8(a->r, brilho), npScale8(a->g, brilho), npScale8(a->b, brilho));
+    return true;
+}
 
-void efeitoFileirasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t y = 0; y < NUM_LINHAS; ++y) {
-        npClear();
-
-        float brilho = ((float)(y + 1)) / NUM_LINHAS;
-
-        acenderFileira(y, r * brilho, g * brilho, b * brilho);
+bool quadroFileirasColoridasReverso(const npAnimacao_t *a) {
+    if (a->quadro >= NUM_LINHAS) return false;
+    uint8_t y = NUM_LINHAS - 1 - a->quadro;
+    uint8_t brilho = (NUM_LINHAS - y) * NP_BRILHO_MAX / NUM_LINHAS;
+    npClear();
+    npSetFileira(y, npScale8(a->r, brilho), npScale8(a->g, brilho), npScale8(a->b, brilho));
+    return true;
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+bool quadroColunasColoridas(const npAnimacao_t *a) {
+    uint8_t x = a->quadro;
+    if (x >= NUM_COLUNAS) return false;
+    uint8_t brilho = (x + 1) * NP_BRILHO_MAX / NUM_COLUNAS;
+    npClear();
+    npSetColuna(x, npScale8(a->r, brilho), npScale8(a->g, brilho), npScale8(a->b, brilho));
+    return true;
 }
 
-void efeitoFileirasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int8_t y = NUM_LINHAS - 1; y >= 0; --y) {
-        npClear();
+bool quadroColunasColoridasReverso(const npAnimacao_t *a) {
+    if (a->quadro >= NUM_COLUNAS) return false;
+    uint8_t x = NUM_COLUNAS - 1 - a->quadro;
+    uint8_t brilho = (NUM_COLUNAS - x) * NP_BRILHO_MAX / NUM_COLUNAS;
+    npClear();
+    npSetColuna(x, npScale8(a->r, brilho), npScale8(a->g, brilho), npScale8(a->b, brilho));
+    return true;
+}
 
-        float brilho = ((float)(NUM_LINHAS - y)) / NUM_LINHAS;
+// === Versões bloqueantes (mesma sequência de quadros, com espera entre eles) ===
 
-        acenderFileira(y, r * brilho, g * brilho, b * brilho);
+// Preenche a matriz em espiral do canto superior esquerdo ao centro
+void efeitoEspiral(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroEspiral, r, g, b, delay_ms);
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+// Efeito de onda vertical com brilho suavizado por linha
+void efeitoOndaVertical(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroOndaVertical, r, g, b, delay_ms);
 }
 
+// Preenche a matriz em espiral do canto superior esquerdo ao centro, inversa.
+void efeitoEspiralInversa(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroEspiralInversa, r, g, b, delay_ms);
+}
 
-void efeitoColunasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t x = 0; x < NUM_COLUNAS; ++x) {
-        npClear();
+//Onda com efeito vertical brilho
+void efeitoOndaVerticalBrilho(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroOndaVerticalBrilho, r, g, b, delay_ms);
+}
 
-        float brilho = ((float)(x + 1)) / NUM_COLUNAS;
+void efeitoFileirasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroFileirasColoridas, r, g, b, delay_ms);
+}
 
-        acenderColuna(x, r * brilho, g * brilho, b * brilho);
+void efeitoFileirasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroFileirasColoridasReverso, r, g, b, delay_ms);
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+void efeitoColunasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    npAnimBloqueante(quadroColunasColoridas, r, g, b, delay_ms);
 }
 
 void efeitoColunasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int8_t x = NUM_COLUNAS - 1; x >= 0; --x) {
-        npClear();
-
-        float brilho = ((float)(NUM_COLUNAS - x)) / NUM_COLUNAS;
-
-        acenderColuna(x, r * brilho, g * brilho, b * brilho);
-
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+    npAnimBloqueante(quadroColunasColoridasReverso, r, g, b, delay_ms);
 }
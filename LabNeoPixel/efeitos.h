@@ -2,7 +2,7 @@
 #define EFEITOS_H
 
 #include <stdint.h>
-#include "LabNeoPixel/efeitos.h"
+#include "animacao.h"
 
 
 void acenderFileira(uint8_t y, uint8_t r, uint8_t g, uint8_t b);
@@ -16,4 +16,14 @@ void efeitoFileirasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t de
 void efeitoColunasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
 void efeitoColunasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
 
+// Geradores de quadros para o motor de animação (npAnimTocar / npAnimStep)
+bool quadroEspiral(const npAnimacao_t *a);
+bool quadroEspiralInversa(const npAnimacao_t *a);
+bool quadroOndaVertical(const npAnimacao_t *a);
+bool quadroOndaVerticalBrilho(const npAnimacao_t *a);
+bool quadroFileirasColoridas(const npAnimacao_t *a);
+bool quadroFileirasColoridasReverso(const npAnimacao_t *a);
+bool quadroColunasColoridas(const npAnimacao_t *a);
+bool quadroColunasColoridasReverso(const npAnimacao_t *a);
+
 #endif
\ No newline at end of file
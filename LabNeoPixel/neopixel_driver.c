@@ -1,56 +1,338 @@
+#include <string.h>
 #include "neopixel_driver.h"
 #include "ws2818b.pio.h"
+#include "hardware/dma.h"
+#include "led_index_table.h" // gerado no build a partir de NUM_COLUNAS / NUM_LINHAS
 
 npLED_t leds[LED_COUNT];
 PIO np_pio;
 int sm;
 
-void npInit(uint pin) {
-    uint offset = pio_add_program(pio0, &ws2818b_program);
-    np_pio = pio0;
-    sm = 0; // Usar SM 0 fixamente
-    pio_sm_claim(np_pio, sm);
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
-    npClear();
+// Quadro da matriz principal no formato da FIFO do PIO: GRB em 24 bits, alinhado à esquerda (bits 31..8)
+static uint32_t np_words[LED_COUNT];
+npFita_t np_matriz = {.leds = leds, .words = np_words, .count = LED_COUNT, .dma_chan = -1};
+
+uint32_t np_writes_skipped = 0;
+
+// Offset do programa ws2818b em cada bloco PIO (-1 = ainda não carregado)
+static int np_program_offset[2] = {-1, -1};
+
+// Camadas do compositor: pixel opaco onde o bit do LED está em 'mask'
+#define NP_MASK_WORDS ((LED_COUNT + 31) / 32)
+typedef struct {
+    npLED_t px[LED_COUNT];
+    uint32_t mask[NP_MASK_WORDS];
+} npLayer_t;
+
+// Correção gama (2.2): 255 * (v / 255)^2.2
+static const uint8_t np_gamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+// Brilho e gama combinados numa só tabela, refeita apenas quando o brilho muda
+static uint8_t np_brilho_lut[256];
+static int np_brilho_lut_nivel = -1;
+
+static npLayer_t np_layers[NP_N_CAMADAS];
+_Static_assert(LED_INDEX_TABLE_COLUNAS == NUM_COLUNAS && LED_INDEX_TABLE_LINHAS == NUM_LINHAS,
+               "led_index_table.h desatualizado");
+
+// 24 bits a 800 kHz por LED + reset de pelo menos 50 us
+#define NP_US_PER_LED 30
+#define NP_RESET_US 60
+
+static inline uint32_t npGRBWord(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
 }
 
-void npWrite(void) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
+// Palavra da FIFO de um LED, opcionalmente passando pela tabela de brilho/gama
+static inline uint32_t npPack(const npLED_t *px, const uint8_t *lut) {
+    if (lut) {
+        return npGRBWord(lut[px->R], lut[px->G], lut[px->B]);
     }
+    return npGRBWord(px->R, px->G, px->B);
 }
 
-void npWriteComBrilho(float brilho) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        uint8_t r = leds[i].R * brilho;
-        uint8_t g = leds[i].G * brilho;
-        uint8_t b = leds[i].B * brilho;
-        pio_sm_put_blocking(np_pio, sm, g);
-        pio_sm_put_blocking(np_pio, sm, r);
-        pio_sm_put_blocking(np_pio, sm, b);
+// Aguarda o quadro anterior da fita sair (inclusive o reset) antes de reescrever 'words'
+static void npFitaWaitFrame(const npFita_t *f) {
+    dma_channel_wait_for_finish_blocking(f->dma_chan);
+    while (!time_reached(f->frame_end)) {
+        tight_loop_contents();
     }
 }
 
-void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
-    if (index < LED_COUNT) {
-        leds[index].R = r;
-        leds[index].G = g;
-        leds[index].B = b;
+// Carrega o programa uma vez por bloco e toma uma máquina livre: pio0 primeiro, depois pio1
+static bool npClaimStateMachine(npFita_t *f) {
+    static const PIO blocos[2] = {pio0, pio1};
+
+    for (uint i = 0; i < 2; ++i) {
+        int sm_livre = pio_claim_unused_sm(blocos[i], false);
+        if (sm_livre < 0) {
+            continue;
+        }
+        if (np_program_offset[i] < 0) {
+            if (!pio_can_add_program(blocos[i], &ws2818b_program)) {
+                pio_sm_unclaim(blocos[i], sm_livre);
+                continue;
+            }
+            np_program_offset[i] = pio_add_program(blocos[i], &ws2818b_program);
+        }
+        f->pio = blocos[i];
+        f->sm = sm_livre;
+        ws2818b_program_init(f->pio, f->sm, np_program_offset[i], f->pin, 800000.f);
+        return true;
     }
+    return false;
 }
 
-void npSetAll(uint8_t r, uint8_t g, uint8_t b) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        npSetLED(i, r, g, b);
+// Prepara uma fita de 'count' LEDs no pino 'pin' com buffers fornecidos pelo chamador.
+// Retorna false se não houver máquina de estado livre nos dois blocos PIO; a fita fica
+// sem canal nem máquina (escritas ignoradas, npFitaLiberar() sem efeito).
+bool npFitaInit(npFita_t *f, uint pin, npLED_t *leds_fita, uint32_t *words, uint16_t count) {
+    f->pio = NULL;
+    f->dma_chan = -1; // Nunca o canal 0 de uma fita zerada que falhou
+    f->pin = pin;
+    f->leds = leds_fita;
+    f->words = words;
+    f->count = count;
+    f->words_valid = false;
+    if (!npClaimStateMachine(f)) {
+        return false;
+    }
+
+    f->dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(f->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(f->pio, f->sm, true));
+    dma_channel_configure(f->dma_chan, &c, &f->pio->txf[f->sm], f->words, f->count, false);
+    f->frame_end = get_absolute_time();
+
+    memset(f->leds, 0, count * sizeof(npLED_t));
+    return true;
+}
+
+void npFitaLiberar(npFita_t *f) {
+    if (f->dma_chan >= 0) {
+        npFitaWaitFrame(f);
+        dma_channel_unclaim(f->dma_chan);
+        f->dma_chan = -1;
+    }
+    if (f->pio) {
+        liberar_maquina_pio(f->pio, f->sm);
+        f->pio = NULL;
+    }
+}
+
+void npFitaSetLED(npFita_t *f, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < f->count) {
+        f->leds[index] = (npLED_t){.G = g, .R = r, .B = b};
+    }
+}
+
+void npFitaSetAll(npFita_t *f, uint8_t r, uint8_t g, uint8_t b) {
+    for (uint i = 0; i < f->count; ++i) {
+        f->leds[i] = (npLED_t){.G = g, .R = r, .B = b};
+    }
+}
+
+// Compara sem escrever: não disputa 'words' com um DMA ainda em curso
+static bool npFitaMudou(const npFita_t *f, const uint8_t *lut) {
+    if (!f->words_valid) {
+        return true;
+    }
+    for (uint i = 0; i < f->count; ++i) {
+        if (npPack(&f->leds[i], lut) != f->words[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Empacota as fitas que mudaram e dispara todos os canais DMA de uma vez.
+// Cada fita tem sua máquina de estado, então os quadros saem em paralelo.
+// Quadros idênticos ao último enviado não são retransmitidos.
+static void npFitasCommit(npFita_t *const *fitas, uint n, const uint8_t *lut) {
+    uint32_t canais = 0;
+
+    assert(n <= NP_MAX_FITAS);
+    for (uint k = 0; k < n; ++k) {
+        npFita_t *f = fitas[k];
+        if (f->dma_chan < 0) {
+            continue; // Fita não inicializada
+        }
+        if (!npFitaMudou(f, lut)) {
+            np_writes_skipped++;
+            continue;
+        }
+        npFitaWaitFrame(f);
+        for (uint i = 0; i < f->count; ++i) {
+            f->words[i] = npPack(&f->leds[i], lut);
+        }
+        f->words_valid = true;
+        dma_channel_set_read_addr(f->dma_chan, f->words, false);
+        dma_channel_set_trans_count(f->dma_chan, f->count, false);
+        canais |= 1u << f->dma_chan;
+    }
+    if (canais == 0) {
+        return;
+    }
+
+    absolute_time_t agora = get_absolute_time();
+    dma_start_channel_mask(canais);
+    for (uint k = 0; k < n; ++k) {
+        npFita_t *f = fitas[k];
+        if (f->dma_chan >= 0 && (canais & (1u << f->dma_chan))) {
+            f->frame_end = delayed_by_us(agora, f->count * NP_US_PER_LED + NP_RESET_US);
+        }
+    }
+}
+
+// Refaz a tabela de brilho/gama se o nível mudou
+static const uint8_t *npBrilhoLut(uint8_t brilho) {
+    if (np_brilho_lut_nivel != brilho) {
+        for (uint v = 0; v < 256; ++v) {
+            np_brilho_lut[v] = np_gamma8[npScale8(v, brilho)];
+        }
+        np_brilho_lut_nivel = brilho;
+    }
+    return np_brilho_lut;
+}
+
+void npFitasWrite(npFita_t *const *fitas, uint n) {
+    npFitasCommit(fitas, n, NULL);
+}
+
+// Escala de brilho em ponto fixo (0..255) seguida da correção gama: um acesso à tabela por canal
+void npFitasWriteComBrilho8(npFita_t *const *fitas, uint n, uint8_t brilho) {
+    npFitasCommit(fitas, n, npBrilhoLut(brilho));
+}
+
+// Não bloqueia: empacota o quadro e o envia por DMA (espera apenas se o anterior ainda estiver saindo)
+void npFitaWrite(npFita_t *f) {
+    npFitasCommit(&f, 1, NULL);
+}
+
+// Indica se o último quadro da fita já foi transmitido e travado pelos LEDs
+bool npFitaWriteDone(const npFita_t *f) {
+    if (f->dma_chan < 0) {
+        return true;
     }
+    return !dma_channel_is_busy(f->dma_chan) && time_reached(f->frame_end);
+}
+
+// === Matriz principal ===
+
+// Retorna false se a matriz não pôde ser inicializada (sem máquina PIO livre); ela fica apagada
+bool npInit(uint pin) {
+    if (!npFitaInit(&np_matriz, pin, leds, np_words, LED_COUNT)) {
+        np_pio = NULL;
+        sm = -1;
+        return false;
+    }
+    np_pio = np_matriz.pio;
+    sm = np_matriz.sm;
+    return true;
+}
+
+void npWrite(void) {
+    npFitaWrite(&np_matriz);
+}
+
+void npWriteComBrilho8(uint8_t brilho) {
+    npFita_t *f = &np_matriz;
+    npFitasWriteComBrilho8(&f, 1, brilho);
+}
+
+// Compatibilidade: converte o fator 0.0..1.0 uma vez por quadro
+void npWriteComBrilho(float brilho) {
+    if (brilho <= 0.0f) {
+        brilho = 0.0f;
+    } else if (brilho >= 1.0f) {
+        brilho = 1.0f;
+    }
+    npWriteComBrilho8((uint8_t)(brilho * NP_BRILHO_MAX + 0.5f));
+}
+
+// Força a retransmissão do próximo quadro (ex.: após outro código usar a máquina PIO)
+void npInvalidate(void) {
+    np_matriz.words_valid = false;
+}
+
+bool npWriteDone(void) {
+    return npFitaWriteDone(&np_matriz);
+}
+
+void npSetLED(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    npFitaSetLED(&np_matriz, index, r, g, b);
+}
+
+void npSetAll(uint8_t r, uint8_t g, uint8_t b) {
+    npFitaSetAll(&np_matriz, r, g, b);
 }
 
 void npClear(void) {
     npSetAll(0, 0, 0);
 }
 
+void npLayerSetLED(uint camada, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (camada < NP_N_CAMADAS && index < LED_COUNT) {
+        np_layers[camada].px[index] = (npLED_t){.G = g, .R = r, .B = b};
+        np_layers[camada].mask[index / 32] |= 1u << (index % 32);
+    }
+}
+
+void npLayerSetAll(uint camada, uint8_t r, uint8_t g, uint8_t b) {
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        npLayerSetLED(camada, i, r, g, b);
+    }
+}
+
+void npLayerClear(uint camada) {
+    if (camada < NP_N_CAMADAS) {
+        memset(np_layers[camada].mask, 0, sizeof(np_layers[camada].mask));
+    }
+}
+
+// Copia um quadro inteiro para a camada (todos os pixels opacos)
+void npLayerSetFrame(uint camada, const npLED_t *quadro) {
+    if (camada < NP_N_CAMADAS) {
+        for (uint i = 0; i < LED_COUNT; ++i) {
+            npLayerSetLED(camada, i, quadro[i].R, quadro[i].G, quadro[i].B);
+        }
+    }
+}
+
+// Monta 'leds[]' com as camadas (a de maior índice fica por cima; fundo apagado) e envia
+void npComposeWrite(void) {
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        npLED_t px = {0, 0, 0};
+        for (uint c = 0; c < NP_N_CAMADAS; ++c) {
+            if (np_layers[c].mask[i / 32] & (1u << (i % 32))) {
+                px = np_layers[c].px[i];
+            }
+        }
+        leds[i] = px;
+    }
+    npWrite();
+}
+
 void liberar_maquina_pio(PIO pio, uint sm_id) {
     if (sm_id < 4) {
         pio_sm_set_enabled(pio, sm_id, false);
@@ -58,9 +340,33 @@ void liberar_maquina_pio(PIO pio, uint sm_id) {
     }
 }
 
+// Mapeamento serpentina (x, y) → índice, consultado na tabela gerada
 uint getLEDIndex(uint x, uint y) {
     if (x >= NUM_COLUNAS || y >= NUM_LINHAS) return 0;
-    uint linha_fisica = NUM_LINHAS - 1 - y;
-    uint base = linha_fisica * NUM_COLUNAS;
-    return (linha_fisica % 2 == 0) ? base + (NUM_COLUNAS - 1 - x) : base + x;
+    return led_index_table[y][x];
+}
+
+// === Acesso 2D à matriz: escritas diretas em leds[] através da tabela ===
+
+void npSetXY(uint x, uint y, uint8_t r, uint8_t g, uint8_t b) {
+    if (x < NUM_COLUNAS && y < NUM_LINHAS) {
+        leds[led_index_table[y][x]] = (npLED_t){.G = g, .R = r, .B = b};
+    }
+}
+
+void npSetFileira(uint y, uint8_t r, uint8_t g, uint8_t b) {
+    if (y >= NUM_LINHAS) return;
+    const npLED_t cor = {.G = g, .R = r, .B = b};
+    const LED_INDEX_TABLE_TYPE *linha = led_index_table[y];
+    for (uint x = 0; x < NUM_COLUNAS; ++x) {
+        leds[linha[x]] = cor;
+    }
+}
+
+void npSetColuna(uint x, uint8_t r, uint8_t g, uint8_t b) {
+    if (x >= NUM_COLUNAS) return;
+    const npLED_t cor = {.G = g, .R = r, .B = b};
+    for (uint y = 0; y < NUM_LINHAS; ++y) {
+        leds[led_index_table[y][x]] = cor;
+    }
 }
@@ -1,34 +1,89 @@
 #ifndef NEOPIXEL_DRIVER_H
 #define NEOPIXEL_DRIVER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "hardware/pio.h"
 
-#define LED_COUNT 25
 #define LED_PIN 7
 #define NUM_COLUNAS 5
 #define NUM_LINHAS 5
+#define LED_COUNT (NUM_COLUNAS * NUM_LINHAS)
 #define COR_APAGA   0
 #define COR_MIN     64
 #define COR_INTER   128
 #define COR_ALTA    192
 
+#define NP_BRILHO_MAX 255
+
+// Camadas do compositor (a de maior índice fica por cima)
+#ifndef NP_N_CAMADAS
+#define NP_N_CAMADAS 2
+#endif
+
+// Fitas simultâneas: 4 máquinas de estado em cada um dos dois blocos PIO
+#define NP_MAX_FITAS 8
 
 typedef struct {
     uint8_t G, R, B;
 } npLED_t;
 
+// Contexto de uma fita: cada uma tem sua máquina PIO, seu canal DMA e seus buffers
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint pin;
+    uint16_t count;
+    npLED_t *leds;    // Cores editadas pela aplicação ('count' LEDs)
+    uint32_t *words;  // Quadro no formato da FIFO, lido pelo DMA ('count' palavras)
+    int dma_chan;
+    absolute_time_t frame_end; // Fim do quadro no fio, incluindo o reset (latch)
+    bool words_valid;          // 'words' é a cópia do que os LEDs exibem
+} npFita_t;
+
+// Escala 'v' por 'escala'/255 em ponto fixo (255 mantém o valor)
+static inline uint8_t npScale8(uint8_t v, uint8_t escala) {
+    return (uint8_t)(((uint16_t)v * (escala + 1u)) >> 8);
+}
+
+// Fita da matriz principal, usada pela API sem contexto (npInit, npWrite, ...)
+extern npFita_t np_matriz;
 extern npLED_t leds[LED_COUNT];
 extern PIO np_pio;
 extern int sm;
+extern uint32_t np_writes_skipped; // Escritas descartadas por quadro idêntico ao anterior
+
+// === API por fita ===
+bool npFitaInit(npFita_t *f, uint pin, npLED_t *leds, uint32_t *words, uint16_t count);
+void npFitaLiberar(npFita_t *f);
+void npFitaSetLED(npFita_t *f, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+void npFitaSetAll(npFita_t *f, uint8_t r, uint8_t g, uint8_t b);
+void npFitaWrite(npFita_t *f);
+bool npFitaWriteDone(const npFita_t *f);
+// Envia várias fitas em paralelo: o tempo de atualização é o da fita mais longa
+void npFitasWrite(npFita_t *const *fitas, uint n);
+void npFitasWriteComBrilho8(npFita_t *const *fitas, uint n, uint8_t brilho);
 
-void npInit(uint pin);
+// === API da matriz principal ===
+bool npInit(uint pin);
 void npWrite(void);
 void npWriteComBrilho(float brilho);
-void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
+void npWriteComBrilho8(uint8_t brilho);
+bool npWriteDone(void);
+void npInvalidate(void);
+void npSetLED(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
 void npSetAll(uint8_t r, uint8_t g, uint8_t b);
 void npClear(void);
 void liberar_maquina_pio(PIO pio, uint sm);
 uint getLEDIndex(uint x, uint y);
+void npSetXY(uint x, uint y, uint8_t r, uint8_t g, uint8_t b);
+void npSetFileira(uint y, uint8_t r, uint8_t g, uint8_t b);
+void npSetColuna(uint x, uint8_t r, uint8_t g, uint8_t b);
+
+void npLayerSetLED(uint camada, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+void npLayerSetAll(uint camada, uint8_t r, uint8_t g, uint8_t b);
+void npLayerClear(uint camada);
+void npLayerSetFrame(uint camada, const npLED_t *quadro);
+void npComposeWrite(void);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,253 @@
+/**
+ * @file bench_io.c
+ * @brief On-target I/O benchmark (`cyclic-scheduler-bench`).
+ *
+ * Runs each I/O path of the firmware through the production drivers and prints, over USB,
+ * the CPU time spent in the call and the time until the transfer is complete on the wire:
+ *
+ * - OLED: full and partial `render_on_display()` (blocking), full `render_on_display_async()`
+ *   (DMA), and the full frame with I2C at 400 kHz and 1 MHz.
+ * - NeoPixel: `npWrite()` through DMA versus feeding the PIO FIFO with `pio_sm_put_blocking()`.
+ * - ADC: task 1 block acquisition at several conversion rates (clkdivs).
+ *
+ * Intervals shorter than the 24-bit SysTick range are measured in clk_sys cycles; longer ones
+ * are converted from the microsecond timer. Throughput is the payload (I2C data bytes,
+ * NeoPixel GRB bytes or ADC samples of 2 bytes) over the wire time.
+ *
+ * The suite runs once the USB serial port is opened and again on every key press.
+ *
+ * Dependencies:
+ * - setup.h, ssd1306.h, neopixel_driver.h and tarefa1_temp.h, exactly as in main.c.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/structs/systick.h"
+
+#include "setup.h"
+#include "ssd1306.h"
+#include "ssd1306_i2c.h"
+#include "neopixel_driver.h"
+#include "tarefa1_temp.h"
+
+// SysTick counts down from this value at clk_sys (~134 ms at 125 MHz before wrapping)
+#define SYSTICK_MAX 0x00FFFFFFu
+
+// Samples per ADC run: short windows keep the whole suite under a few seconds
+#define BENCH_ADC_JANELA_US 100000
+
+#define BENCH_I2C_PADRAO_HZ (400 * 1000)
+#define BENCH_I2C_RAPIDO_HZ (1000 * 1000)
+
+/**
+ * @brief One measured interval: elapsed clk_sys cycles and microseconds.
+ */
+typedef struct
+{
+        uint32_t inicio_tick;
+        uint64_t inicio_us;
+        uint64_t ciclos;
+        uint64_t us;
+} medida_t;
+
+// Control byte slot + framebuffer, as in setup.c. Not registered as a double buffer, so the
+// blocking render_on_display() copies it like any caller's buffer
+static uint8_t quadro[ssd1306_frame_length] = {0x40};
+
+static void medida_iniciar(medida_t *m)
+{
+        m->inicio_us = time_us_64();
+        m->inicio_tick = systick_hw->cvr;
+}
+
+static void medida_parar(medida_t *m)
+{
+        uint32_t fim_tick = systick_hw->cvr;
+        m->us = time_us_64() - m->inicio_us;
+
+        // Below the wrap period the SysTick difference is exact; above it only the timer is valid
+        uint64_t ciclos_por_us = clock_get_hz(clk_sys) / 1000000;
+        if (m->us * ciclos_por_us < SYSTICK_MAX)
+                m->ciclos = (m->inicio_tick - fim_tick) & SYSTICK_MAX;
+        else
+                m->ciclos = m->us * ciclos_por_us;
+}
+
+/**
+ * @brief Prints one result line.
+ *
+ * @param nome Path under test
+ * @param cpu Time spent inside the call
+ * @param total Time until the transfer completed (CPU time for blocking paths)
+ * @param bytes Payload transferred, for the throughput column
+ */
+static void relatar(const char *nome, const medida_t *cpu, const medida_t *total, uint32_t bytes)
+{
+        double kbps = total->us ? bytes * 1000.0 / total->us : 0.0; // bytes/us = MB/s → kB/s
+        printf("%-34s %10llu ciclos %9llu us CPU | %9llu us total | %9.1f kB/s\n",
+               nome,
+               (unsigned long long)cpu->ciclos,
+               (unsigned long long)cpu->us,
+               (unsigned long long)total->us,
+               kbps);
+}
+
+/**
+ * @brief Blocking render of `area`, at the current I2C baudrate.
+ */
+static void bench_render(const char *nome, struct render_area *area)
+{
+        medida_t m;
+        uint8_t *ssd = &quadro[1] + area->start_page * ssd1306_width + area->start_column;
+
+        ssd1306_flush_wait();
+        medida_iniciar(&m);
+        render_on_display(ssd, area);
+        medida_parar(&m);
+        relatar(nome, &m, &m, area->buffer_length + 1); // + control byte
+}
+
+static void bench_oled(void)
+{
+        struct render_area cheia = {
+                .start_column = 0,
+                .end_column = ssd1306_width - 1,
+                .start_page = 0,
+                .end_page = ssd1306_n_pages - 1};
+        struct render_area parcial = {// One page, half the width: a typical damaged span
+                .start_column = 32,
+                .end_column = 95,
+                .start_page = 4,
+                .end_page = 4};
+        calculate_render_area_buffer_length(&cheia);
+        calculate_render_area_buffer_length(&parcial);
+
+        for (uint i = 0; i < ssd1306_buffer_length; i++)
+                quadro[1 + i] = (uint8_t)(i * 37); // Arbitrary pattern
+
+        printf("\n-- OLED (SSD1306, I2C1) --\n");
+        bench_render("render_on_display cheia 400k", &cheia);
+        bench_render("render_on_display parcial 400k", &parcial);
+
+        // Asynchronous path: the CPU only queues the DMA words
+        medida_t cpu, total;
+        ssd1306_flush_wait();
+        medida_iniciar(&total);
+        medida_iniciar(&cpu);
+        render_on_display_async(&quadro[1], &cheia);
+        medida_parar(&cpu);
+        ssd1306_flush_wait();
+        medida_parar(&total);
+        relatar("render_on_display_async cheia 400k", &cpu, &total, cheia.buffer_length + 1);
+
+        uint baud = i2c_set_baudrate(i2c1, BENCH_I2C_RAPIDO_HZ);
+        printf("I2C1 a %u Hz efetivos:\n", baud);
+        bench_render("render_on_display cheia 1M", &cheia);
+        bench_render("render_on_display parcial 1M", &parcial);
+        i2c_set_baudrate(i2c1, BENCH_I2C_PADRAO_HZ);
+}
+
+static void bench_neopixel(void)
+{
+        medida_t cpu, total;
+
+        printf("\n-- NeoPixel (%u LEDs, PIO + DMA) --\n", LED_COUNT);
+        if (!np_matriz.pio)
+        {
+                printf("Matriz não inicializada: nenhuma máquina de estado PIO livre\n");
+                return;
+        }
+
+        // DMA: the call prepares the GRB words and starts the channel
+        npSetAll(0x10, 0x20, 0x30);
+        npInvalidate();
+        while (!npWriteDone())
+                tight_loop_contents();
+        medida_iniciar(&total);
+        medida_iniciar(&cpu);
+        npWrite();
+        medida_parar(&cpu);
+        while (!npWriteDone())
+                tight_loop_contents();
+        medida_parar(&total);
+        relatar("npWrite DMA", &cpu, &total, LED_COUNT * 3);
+
+        // Blocking: the same words pushed by the CPU, as before the DMA driver
+        medida_iniciar(&cpu);
+        for (uint i = 0; i < np_matriz.count; i++)
+                pio_sm_put_blocking(np_matriz.pio, np_matriz.sm, np_matriz.words[i]);
+        medida_parar(&cpu);
+        total = cpu;
+        while (!pio_sm_is_tx_fifo_empty(np_matriz.pio, np_matriz.sm))
+                tight_loop_contents();
+        medida_parar(&total); // Last words still leave the FIFO after the loop
+        relatar("npWrite pio_sm_put_blocking", &cpu, &total, LED_COUNT * 3);
+        sleep_us(100); // Latch before the next test
+}
+
+static void bench_adc(void)
+{
+        static const uint32_t taxas_hz[] = {0, 250000, 100000, 10000}; // 0 = free-running 500 kS/s
+
+        printf("\n-- ADC (Tarefa 1, janela de %u ms por DMA) --\n", BENCH_ADC_JANELA_US / 1000);
+        for (uint i = 0; i < count_of(taxas_hz); i++)
+        {
+                tarefa1_config_t config = {
+                        .taxa_hz = taxas_hz[i],
+                        .janela_us = BENCH_ADC_JANELA_US,
+                        .sobreamostragem = 1};
+                tarefa1_configurar(&config);
+
+                uint32_t taxa = taxas_hz[i] ? taxas_hz[i] : 500000;
+                uint32_t amostras = (uint32_t)((uint64_t)taxa * BENCH_ADC_JANELA_US / 1000000);
+                float clkdiv = taxas_hz[i] ? 48000000.0f / taxa - 1.0f : 0.0f;
+
+                medida_t m;
+                medida_iniciar(&m);
+                float media = tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL);
+                medida_parar(&m);
+
+                char nome[40];
+                snprintf(nome, sizeof(nome), "ADC clkdiv %.0f (%lu S/s)", clkdiv, (unsigned long)taxa);
+                relatar(nome, &m, &m, amostras * 2);
+                printf("%34s %lu amostras, %.1f kS/s, média %.2f °C\n", "",
+                       (unsigned long)amostras, amostras * 1000.0 / m.us, media);
+        }
+
+        tarefa1_config_t padrao = TAREFA1_CONFIG_PADRAO;
+        tarefa1_configurar(&padrao);
+}
+
+/**
+ * @brief Brings up the same peripherals as the firmware and runs the suite on demand.
+ */
+int main()
+{
+        setup(); // Inicializações: ADC, DMA, interrupções, OLED, etc.
+
+        systick_hw->rvr = SYSTICK_MAX;
+        systick_hw->cvr = 0;
+        systick_hw->csr = 0x5; // Enable, clocked by clk_sys
+
+        while (!stdio_usb_connected())
+                sleep_ms(100);
+
+        while (true)
+        {
+                printf("\n=== cyclic-scheduler-bench: clk_sys %lu Hz ===\n", (unsigned long)clock_get_hz(clk_sys));
+                bench_oled();
+                bench_neopixel();
+                bench_adc();
+                printf("\nPressione uma tecla para repetir.\n");
+
+                while (getchar_timeout_us(1000000) == PICO_ERROR_TIMEOUT)
+                        ;
+        }
+
+        return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: cyclic_executive.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Executivo cíclico com tabela de quadros estática.
+ *
+ *      Um único timer repetitivo (taxa fixa) marca o início
+ *      de cada quadro menor; o laço principal dorme com
+ *      '__wfi()' até o próximo tique e então executa, em
+ *      ordem, as tarefas alocadas ao quadro. Ao final do
+ *      quadro maior a tabela recomeça do quadro 0.
+ *
+ *      Se um quadro exceder o quadro menor, os tiques perdidos
+ *      são contados em 'cyclic_frame_overruns' e o índice do
+ *      quadro avança junto, mantendo a tabela alinhada com o
+ *      tempo real.
+ *
+ *      O watchdog só é alimentado ao fim de um quadro maior
+ *      sem atrasos nem estouros de WCET.
+ *
+ *      Com TELEMETRIA, o anel é drenado no tempo ocioso de
+ *      cada quadro menor, antes de dormir.
+ *
+ *      Com HISTORICO, 'historico_tarefa()' roda uma vez por
+ *      quadro menor, após as tarefas da tabela (no máximo uma
+ *      operação de flash por quadro).
+ *
+ *  Relacionamento:
+ *      - 'cyclic_schedule.h' é gerado a partir de 'cyclic_tasks.txt'.
+ *      - As funções das tarefas são fornecidas por 'tarefas.c'.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "cyclic_executive.h"
+#include "profiler.h"
+#if TELEMETRIA
+#include "telemetria.h"
+#endif
+#if HISTORICO
+#include "historico.h"
+#endif
+
+_Static_assert(CYCLIC_WATCHDOG_MS <= 8388, "o watchdog do RP2040 vai até ~8,3 s");
+
+volatile uint32_t cyclic_frame_overruns = 0;
+uint32_t cyclic_wcet_overruns[CYCLIC_N_TASKS];
+
+// Tiques do quadro menor gerados pelo timer
+static volatile uint32_t frame_ticks = 0;
+
+/**
+ * @brief Callback do timer do quadro menor.
+ */
+static bool cyclic_frame_callback(repeating_timer_t *rt)
+{
+    frame_ticks++;
+    return true;
+}
+
+void cyclic_executive_run(const scheduler_entry_t entries[CYCLIC_N_TASKS])
+{
+    static repeating_timer_t frame_timer;
+    uint32_t handled = 0;
+    uint frame = 0;
+    bool major_fault = false;
+
+    profiler_init(CYCLIC_N_TASKS);
+    for (uint i = 0; i < CYCLIC_N_TASKS; i++)
+        profiler_nomear(i, cyclic_task_names[i]);
+
+    // Período negativo: intervalo entre inícios de callback (taxa fixa)
+    add_repeating_timer_ms(-CYCLIC_MINOR_FRAME_MS, cyclic_frame_callback, NULL, &frame_timer);
+    watchdog_enable(CYCLIC_WATCHDOG_MS, true);
+
+    while (true)
+    {
+        const cyclic_frame_t *current = &cyclic_frames[frame];
+
+        for (uint i = 0; i < current->count; i++)
+        {
+            uint task = current->tasks[i];
+            uint32_t inicio = profiler_agora();
+
+            entries[task]();
+
+            uint32_t duracao_us = profiler_agora() - inicio;
+            profiler_registrar(task, duracao_us);
+            if (duracao_us > cyclic_task_wcet_ms[task] * 1000)
+            {
+                cyclic_wcet_overruns[task]++;
+                major_fault = true;
+            }
+        }
+
+#if HISTORICO
+        historico_tarefa(); // Fora da tabela: usa a folga do quadro
+#endif
+
+        while (frame_ticks == handled)
+        {
+#if TELEMETRIA
+            // Tempo ocioso do quadro: drena a telemetria antes de dormir
+            if (telem_cabeca != telem_cauda)
+            {
+                telem_drenar();
+                continue;
+            }
+#endif
+            // Verifica e dorme com as interrupções mascaradas: um tique que chegue
+            // entre os dois ainda acorda o núcleo
+            uint32_t irq = save_and_disable_interrupts();
+            if (frame_ticks == handled)
+                __wfi(); // Aguarda o próximo quadro menor
+            restore_interrupts(irq);
+        }
+
+        uint32_t elapsed = frame_ticks - handled;
+        handled += elapsed;
+        cyclic_frame_overruns += elapsed - 1;
+        if (elapsed > 1)
+            major_fault = true;
+
+        if (frame + elapsed >= CYCLIC_N_FRAMES)
+        {
+            // Fim do quadro maior: só alimenta o watchdog se ele foi saudável
+            if (!major_fault)
+                watchdog_update();
+            major_fault = false;
+        }
+        frame = (frame + elapsed) % CYCLIC_N_FRAMES;
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: cyclic_executive.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface do executivo cíclico clássico (quadros maior
+ *      e menor), alternativo ao escalonador dinâmico de
+ *      'scheduler.c'.
+ *
+ *      A tabela de quadros 'cyclic_frames' é gerada durante o
+ *      build por 'tools/gen_cyclic_schedule.cmake' a partir de
+ *      'cyclic_tasks.txt'; conjuntos de tarefas inviáveis
+ *      interrompem a compilação.
+ *
+ *      Habilitado com a opção CMake CYCLIC_EXECUTIVE=ON.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef CYCLIC_EXECUTIVE_H
+#define CYCLIC_EXECUTIVE_H
+
+#include <stdint.h>
+#include "scheduler.h"      // scheduler_entry_t
+#include "cyclic_schedule.h" // gerado no build
+
+// Sem quadro maior saudável por este tempo, o watchdog reinicia o sistema
+#ifndef CYCLIC_WATCHDOG_MS
+#define CYCLIC_WATCHDOG_MS (2 * CYCLIC_MAJOR_FRAME_MS)
+#endif
+
+// Quadros que começaram atrasados (o anterior excedeu o quadro menor)
+extern volatile uint32_t cyclic_frame_overruns;
+
+// Execuções que ultrapassaram o WCET declarado em cyclic_tasks.txt
+extern uint32_t cyclic_wcet_overruns[CYCLIC_N_TASKS];
+
+/**
+ * @brief Executa o executivo cíclico indefinidamente.
+ *
+ * Um único timer acorda o laço a cada quadro menor; as tarefas
+ * do quadro corrente são executadas na ordem da tabela. O watchdog
+ * é habilitado aqui e alimentado ao fim de cada quadro maior sem
+ * quadros atrasados nem estouros de WCET. Não retorna.
+ *
+ * @param entries Função de cada tarefa, indexada por CYCLIC_TASK_<NOME>
+ */
+void cyclic_executive_run(const scheduler_entry_t entries[CYCLIC_N_TASKS]);
+
+#endif // CYCLIC_EXECUTIVE_H
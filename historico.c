@@ -0,0 +1,367 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: historico.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Gravação incremental do histórico de temperaturas na
+ *      flash e despejo binário pela USB.
+ *
+ *      As operações de flash passam por 'flash_safe_execute()',
+ *      que desabilita as interrupções e, no modo dual-core,
+ *      pausa o núcleo 1 durante a operação. Um apagamento de
+ *      setor (~45 ms típicos) só acontece uma vez a cada 15
+ *      páginas gravadas; a gravação de uma página leva ~1 ms.
+ *      Por isso o histórico exige uma aquisição por blocos: os
+ *      modos livres da Tarefa 1 (ping-pong e streaming) perderiam
+ *      metades com as interrupções desabilitadas.
+ *
+ *  Relacionamento:
+ *      - 'tarefas.c' registra a média a cada ciclo da Tarefa 3 e
+ *        inclui 'historico_tarefa()' na tabela do escalonador.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "historico.h"
+
+#define HIST_BYTES (HIST_SETORES * FLASH_SECTOR_SIZE)
+#define HIST_OFFSET (PICO_FLASH_SIZE_BYTES - HIST_BYTES)
+#define HIST_PAGINAS_POR_SETOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define HIST_CABECALHO_PAGINA 7  // len + índice + primeira amostra
+#define HIST_PAGINA_MAX 254      // 0xFF no byte de tamanho marca página livre
+#define HIST_FLASH_TIMEOUT_MS 10 // Espera pelo núcleo 1 antes de desistir
+
+_Static_assert((HIST_RAM_AMOSTRAS & (HIST_RAM_AMOSTRAS - 1)) == 0, "HIST_RAM_AMOSTRAS deve ser potência de 2");
+
+// Com as interrupções desabilitadas durante a operação, a aquisição livre continua sem que
+// as metades concluídas sejam atendidas: apagar um setor (~45 ms) ou gravar uma página (~1 ms)
+// deixa o DMA sobrescrever metades ainda não somadas, corrompendo a média da janela
+#if TAREFA1_STREAMING || TAREFA1_PING_PONG
+#error "HISTORICO mascara as interrupções por até ~45 ms: incompatível com TAREFA1_STREAMING e TAREFA1_PING_PONG"
+#endif
+
+extern char __flash_binary_end;
+
+// Conteúdo da região, lido diretamente pelo XIP
+static const uint8_t *const regiao = (const uint8_t *)(XIP_BASE + HIST_OFFSET);
+
+typedef enum
+{
+    HIST_DESATIVADO,
+    HIST_APAGAR,      // O setor corrente precisa ser apagado
+    HIST_CABECALHO,   // O setor corrente foi apagado e aguarda o cabeçalho
+    HIST_GRAVANDO,
+} hist_estado_t;
+
+static hist_estado_t estado = HIST_DESATIVADO;
+static uint setor;          // Setor corrente
+static uint pagina;         // Próxima página livre do setor corrente
+static uint32_t seq_setor;  // Sequência do setor corrente
+
+// Anel em RAM (produtor: Tarefa 3; consumidor: tarefa do histórico)
+static int16_t anel[HIST_RAM_AMOSTRAS];
+static uint32_t anel_cabeca, anel_cauda;
+static uint32_t descartes;
+
+// Página em montagem
+static uint8_t pagina_buf[FLASH_PAGE_SIZE];
+static uint pagina_len;            // 0 = vazia
+static int16_t ultimo_valor;
+static uint32_t proximo_indice;    // Índice global da próxima amostra
+static absolute_time_t proximo_flush;
+
+// Despejo USB
+static bool despejo_pedido;
+static bool despejando;
+static uint32_t despejo_offset;
+
+typedef struct
+{
+    uint32_t offset;
+    const uint8_t *dados;
+    size_t tamanho;
+} hist_operacao_t;
+
+static void hist_apagar_flash(void *param)
+{
+    const hist_operacao_t *op = param;
+    flash_range_erase(op->offset, op->tamanho);
+}
+
+static void hist_gravar_flash(void *param)
+{
+    const hist_operacao_t *op = param;
+    flash_range_program(op->offset, op->dados, op->tamanho);
+}
+
+static bool hist_executar(void (*func)(void *), uint32_t offset, const uint8_t *dados, size_t tamanho)
+{
+    hist_operacao_t op = {HIST_OFFSET + offset, dados, tamanho};
+    return flash_safe_execute(func, &op, HIST_FLASH_TIMEOUT_MS) == PICO_OK;
+}
+
+static inline const uint8_t *hist_pagina(uint s, uint p)
+{
+    return regiao + s * FLASH_SECTOR_SIZE + p * FLASH_PAGE_SIZE;
+}
+
+static inline uint32_t hist_le_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool hist_setor_valido(uint s, uint32_t *seq)
+{
+    const uint8_t *cab = hist_pagina(s, 0);
+    if (hist_le_u32(cab) != HIST_MAGIC)
+        return false;
+    *seq = hist_le_u32(cab + 4);
+    return true;
+}
+
+/**
+ * @brief Índice seguinte à última amostra de uma página gravada.
+ */
+static uint32_t hist_fim_da_pagina(const uint8_t *p)
+{
+    uint32_t amostras = 1;
+    for (uint i = HIST_CABECALHO_PAGINA; i < p[0]; i++)
+        if (!(p[i] & 0x80)) // Último byte de cada varint
+            amostras++;
+    return hist_le_u32(p + 1) + amostras;
+}
+
+bool historico_init(void)
+{
+    if ((uintptr_t)&__flash_binary_end > (uintptr_t)regiao)
+    {
+        estado = HIST_DESATIVADO;
+        return false;
+    }
+
+    // Setor com a maior sequência é o corrente
+    bool achou = false;
+    for (uint s = 0; s < HIST_SETORES; s++)
+    {
+        uint32_t seq;
+        if (hist_setor_valido(s, &seq) && (!achou || seq > seq_setor))
+        {
+            achou = true;
+            setor = s;
+            seq_setor = seq;
+        }
+    }
+
+    proximo_indice = 0;
+    pagina_len = 0;
+    proximo_flush = make_timeout_time_ms(HIST_FLUSH_MS);
+    if (!achou)
+    {
+        setor = 0;
+        seq_setor = 1;
+        estado = HIST_APAGAR;
+        return true;
+    }
+
+    // Primeira página livre e continuação da numeração
+    pagina = 1;
+    while (pagina < HIST_PAGINAS_POR_SETOR && hist_pagina(setor, pagina)[0] != 0xFF)
+        pagina++;
+    if (pagina > 1)
+        proximo_indice = hist_fim_da_pagina(hist_pagina(setor, pagina - 1));
+    else
+    {
+        // Setor recém-aberto: continua do último do setor anterior, se houver
+        uint anterior = (setor + HIST_SETORES - 1) % HIST_SETORES;
+        uint32_t seq;
+        if (hist_setor_valido(anterior, &seq) && seq + 1 == seq_setor)
+            proximo_indice = hist_fim_da_pagina(hist_pagina(anterior, HIST_PAGINAS_POR_SETOR - 1));
+    }
+
+    if (pagina == HIST_PAGINAS_POR_SETOR)
+    {
+        setor = (setor + 1) % HIST_SETORES;
+        seq_setor++;
+        estado = HIST_APAGAR;
+    }
+    else
+        estado = HIST_GRAVANDO;
+    return true;
+}
+
+void historico_registrar(float temperatura)
+{
+    if (anel_cabeca - anel_cauda >= HIST_RAM_AMOSTRAS)
+    {
+        descartes++;
+        return;
+    }
+    anel[anel_cabeca % HIST_RAM_AMOSTRAS] = (int16_t)(temperatura * 100.0f);
+    anel_cabeca++;
+}
+
+uint32_t historico_descartes(void)
+{
+    return descartes;
+}
+
+/**
+ * @brief Acrescenta uma amostra à página em montagem; false se ela não couber.
+ */
+static bool hist_codificar(int16_t valor)
+{
+    if (pagina_len == 0)
+    {
+        pagina_buf[1] = proximo_indice;
+        pagina_buf[2] = proximo_indice >> 8;
+        pagina_buf[3] = proximo_indice >> 16;
+        pagina_buf[4] = proximo_indice >> 24;
+        pagina_buf[5] = (uint16_t)valor;
+        pagina_buf[6] = (uint16_t)valor >> 8;
+        pagina_len = HIST_CABECALHO_PAGINA;
+    }
+    else
+    {
+        int32_t delta = (int32_t)valor - ultimo_valor;
+        uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        uint8_t bytes[3];
+        uint n = 0;
+        do
+        {
+            bytes[n] = zz & 0x7F;
+            zz >>= 7;
+            if (zz)
+                bytes[n] |= 0x80;
+            n++;
+        } while (zz);
+
+        if (pagina_len + n > HIST_PAGINA_MAX)
+            return false;
+        memcpy(&pagina_buf[pagina_len], bytes, n);
+        pagina_len += n;
+    }
+    ultimo_valor = valor;
+    proximo_indice++;
+    return true;
+}
+
+/**
+ * @brief Grava a página em montagem (completa ou parcial) na próxima página livre.
+ */
+static void hist_gravar_pagina(void)
+{
+    pagina_buf[0] = pagina_len;
+    memset(&pagina_buf[pagina_len], 0xFF, FLASH_PAGE_SIZE - pagina_len);
+    if (!hist_executar(hist_gravar_flash, setor * FLASH_SECTOR_SIZE + pagina * FLASH_PAGE_SIZE, pagina_buf, FLASH_PAGE_SIZE))
+        return; // Núcleo 1 não liberou a flash: tenta de novo na próxima liberação
+
+    pagina_len = 0;
+    proximo_flush = make_timeout_time_ms(HIST_FLUSH_MS);
+    if (++pagina == HIST_PAGINAS_POR_SETOR)
+    {
+        setor = (setor + 1) % HIST_SETORES; // Sobrescreve o setor mais antigo
+        seq_setor++;
+        estado = HIST_APAGAR;
+    }
+}
+
+/**
+ * @brief Envia um trecho do despejo; encerra com o bloco vazio.
+ */
+static void hist_despejar(void)
+{
+    uint orcamento = HIST_DUMP_POR_LIBERACAO;
+
+    while (orcamento > 0)
+    {
+        uint16_t tamanho = HIST_BYTES - despejo_offset < 1024 ? HIST_BYTES - despejo_offset : 1024;
+        const uint8_t *dados = regiao + despejo_offset;
+        uint8_t cab[8] = {'H', 'C',
+                          despejo_offset, despejo_offset >> 8, despejo_offset >> 16, despejo_offset >> 24,
+                          tamanho, tamanho >> 8};
+        uint8_t chk = 0;
+
+        for (uint i = 0; i < sizeof(cab); i++)
+            putchar_raw(cab[i]);
+        for (uint i = 0; i < tamanho; i++)
+        {
+            putchar_raw(dados[i]);
+            chk ^= dados[i];
+        }
+        putchar_raw(chk);
+
+        if (tamanho == 0)
+        {
+            despejando = false;
+            return;
+        }
+        despejo_offset += tamanho;
+        orcamento -= tamanho < orcamento ? tamanho : orcamento;
+    }
+}
+
+void historico_tarefa(void)
+{
+    if (estado == HIST_DESATIVADO)
+        return;
+
+    if (despejando)
+    {
+        hist_despejar();
+        return;
+    }
+    if (getchar_timeout_us(0) == 'H')
+        despejo_pedido = true;
+
+    switch (estado)
+    {
+    case HIST_APAGAR:
+        if (hist_executar(hist_apagar_flash, setor * FLASH_SECTOR_SIZE, NULL, FLASH_SECTOR_SIZE))
+            estado = HIST_CABECALHO;
+        return;
+    case HIST_CABECALHO:
+    {
+        static uint8_t cab[FLASH_PAGE_SIZE];
+        memset(cab, 0xFF, sizeof(cab));
+        uint32_t campos[2] = {HIST_MAGIC, seq_setor};
+        memcpy(cab, campos, sizeof(campos)); // RP2040 é little-endian
+        if (hist_executar(hist_gravar_flash, setor * FLASH_SECTOR_SIZE, cab, FLASH_PAGE_SIZE))
+        {
+            pagina = 1;
+            estado = HIST_GRAVANDO;
+        }
+        return;
+    }
+    default:
+        break;
+    }
+
+    // Codifica o que couber; grava só quando a página enche, no flush periódico ou antes de um despejo
+    while (anel_cauda != anel_cabeca)
+    {
+        if (!hist_codificar(anel[anel_cauda % HIST_RAM_AMOSTRAS]))
+        {
+            hist_gravar_pagina();
+            return;
+        }
+        anel_cauda++;
+    }
+    if (pagina_len > 0 && (despejo_pedido || time_reached(proximo_flush)))
+    {
+        hist_gravar_pagina();
+        return;
+    }
+    if (despejo_pedido)
+    {
+        despejo_pedido = false;
+        despejando = true;
+        despejo_offset = 0;
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: historico.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Histórico de temperaturas persistente em flash
+ *      (opção CMake HISTORICO=ON).
+ *
+ *      As médias de cada ciclo entram num anel em RAM e uma
+ *      tarefa periódica as grava numa região reservada ao fim
+ *      da flash, no máximo uma operação de flash por liberação
+ *      (apagar um setor, gravar o cabeçalho ou gravar uma
+ *      página), de modo que cada parada do XIP é limitada.
+ *
+ *      Formato (HIST_SETORES setores de 4 KB, usados em anel;
+ *      o setor mais antigo é apagado quando o atual enche, o
+ *      que distribui o desgaste igualmente):
+ *          - página 0 do setor: HIST_MAGIC e número de
+ *            sequência do setor (u32 LE), resto em 0xFF;
+ *          - páginas 1..15: [0] bytes usados (0xFF = livre),
+ *            [1..4] índice global da primeira amostra,
+ *            [5..6] primeira amostra (centésimos de °C, s16),
+ *            seguidas dos deltas entre amostras em zigzag +
+ *            varint (1 byte para variações de até ±0,63 °C).
+ *
+ *      Ao receber 'H' pela USB, a região inteira é enviada em
+ *      blocos binários: 'H' 'C', deslocamento (u32), tamanho
+ *      (u16), dados e XOR dos dados; o bloco de tamanho 0
+ *      encerra. 'tools/historico_dump.py' lê e decodifica.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Região reservada: últimos HIST_SETORES setores da flash
+#ifndef HIST_SETORES
+#define HIST_SETORES 16
+#endif
+
+// Amostras aguardando gravação (potência de 2)
+#ifndef HIST_RAM_AMOSTRAS
+#define HIST_RAM_AMOSTRAS 128
+#endif
+
+// Grava a página parcial após este tempo, limitando a perda num reset
+#ifndef HIST_FLUSH_MS
+#define HIST_FLUSH_MS 60000
+#endif
+
+// Bytes do despejo USB enviados por liberação
+#ifndef HIST_DUMP_POR_LIBERACAO
+#define HIST_DUMP_POR_LIBERACAO 4096
+#endif
+
+#define HIST_MAGIC 0x54534948u // "HIST"
+
+/**
+ * @brief Localiza o setor e a página correntes na flash e retoma a numeração.
+ *
+ * @return false se a região reservada colidir com o binário (histórico desativado)
+ */
+bool historico_init(void);
+
+/**
+ * @brief Acrescenta a média de um ciclo ao anel em RAM (não acessa a flash).
+ */
+void historico_registrar(float temperatura);
+
+/**
+ * @brief Tarefa periódica: atende o despejo USB e faz no máximo uma operação de flash.
+ */
+void historico_tarefa(void);
+
+/**
+ * @brief Amostras descartadas por anel cheio.
+ */
+uint32_t historico_descartes(void);
+
+#endif // HISTORICO_H
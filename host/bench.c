@@ -0,0 +1,482 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/bench.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Benchmark do build de simulação no host.
+ *
+ *      1. Escalonador: a tabela de tarefas de 'tarefas.c', a
+ *         mesma do firmware (com as opções TELEMETRIA e
+ *         NEOPIXEL_ANIMACAO do build de host), roda por N
+ *         hiperperíodos de tempo virtual sobre os periféricos
+ *         simulados, com a partida em etapas de 'main()' e as
+ *         assinaturas de 'tarefas_conectar()'. O hiperperíodo é
+ *         estendido a um múltiplo que cubra
+ *         BENCH_TEMP_PERIODO_US. São relatados o overhead de
+ *         despacho no host (tempo de 'scheduler_dispatch()'
+ *         fora das tarefas), os perfis e os contadores de
+ *         supervisão em tempo virtual. A saída das tarefas é
+ *         descartada, exceto com '-v'.
+ *
+ *      2. Micro-benchmarks dos kernels de renderização e de
+ *         conversão (tempo de CPU do host, melhor de
+ *         BENCH_REPETICOES medidas): 'draw_big_char', string
+ *         grande, quadro completo do OLED, 'getLEDIndex',
+ *         conversão dos LEDs para palavras GRB com brilho e a
+ *         análise de tendência.
+ *
+ *      Com '-c' os resultados são gravados em CSV; com '-b' são
+ *      comparados a um CSV anterior e o programa termina com
+ *      código 1 se algum tempo piorar além da tolerância ('-t',
+ *      em %) ou se algum contador de falhas aumentar.
+ *
+ *      Uso: cyclic-scheduler-sim-bench [-n hiperperiodos] [-c saida.csv]
+ *                                      [-b base.csv] [-t tolerancia] [-v]
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pico/stdlib.h"
+#include "sim.h"
+#include "setup.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "tarefas.h"
+#include "tarefa1_temp.h"
+#include "tarefa2_display.h"
+#include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h"
+#include "neopixel_driver.h"
+#include "testes_cores.h"
+#include "ssd1306.h"
+#include "ssd1306_i2c.h"
+#include "big_string_drawer.h"
+#include "font_big_columns.h"
+
+// Definida em 'draw_big_char.h', que não pode ser incluído duas vezes no link
+void draw_big_char(uint8_t *ssd, int x, int y, const uint8_t *columns);
+
+#define BENCH_REPETICOES 5
+#define BENCH_MAX_RESULTADOS 64
+#define BENCH_TOLERANCIA_PADRAO 20.0
+
+// Temperatura simulada: 27 °C ± 3 °C com período de 10 min
+#define BENCH_TEMP_MEDIA_C 27.0
+#define BENCH_TEMP_AMPLITUDE_C 3.0
+#define BENCH_TEMP_PERIODO_US 600000000.0
+
+typedef struct
+{
+    char nome[48];
+    double valor;
+    bool contagem; // Contador de falhas (comparado sem tolerância) em vez de tempo em ns
+} bench_resultado_t;
+
+static bench_resultado_t resultados[BENCH_MAX_RESULTADOS];
+static uint n_resultados;
+
+static void bench_registrar(const char *nome, double valor, bool contagem)
+{
+    assert(n_resultados < BENCH_MAX_RESULTADOS);
+    bench_resultado_t *r = &resultados[n_resultados++];
+    snprintf(r->nome, sizeof(r->nome), "%s", nome);
+    r->valor = valor;
+    r->contagem = contagem;
+}
+
+static inline uint64_t host_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// === Micro-benchmarks ===
+
+static uint8_t ssd_bench[ssd1306_buffer_length];
+static volatile uint sumidouro; // Impede que o compilador descarte os resultados
+static uint iteracao;
+
+static void kernel_draw_big_char(void)
+{
+    draw_big_char(ssd_bench, (iteracao * 16) % 112, 32, big_digit_8_cols);
+}
+
+static void kernel_draw_big_char_desalinhado(void)
+{
+    draw_big_char(ssd_bench, (iteracao * 16) % 112, 35, big_digit_8_cols); // y fora da página
+}
+
+static void kernel_string_grande(void)
+{
+    static const char *const valores[] = {"27.31oC", "-5.80oC", "104.2oC"};
+    sumidouro += draw_big_string_aligned_right(ssd_bench, 32, valores[iteracao % 3]);
+}
+
+/**
+ * @brief Avança o tempo virtual até o próximo evento (fim de um envio por DMA), no máximo 100 µs.
+ */
+static void bench_proximo_evento(void)
+{
+    uint64_t passo = sim_proximo_evento_us() - time_us_64();
+    sim_avancar_us(passo < 100 ? passo : 100);
+}
+
+static void kernel_quadro_oled(void)
+{
+    // O envio do quadro anterior precisa terminar, senão a troca de buffers espera por ele
+    while (ssd1306_flush_busy())
+        bench_proximo_evento();
+    // Temperatura diferente a cada quadro: sempre há colunas alteradas para enviar
+    tarefa2_exibir_oled(20.0f + (iteracao % 200) * 0.05f, (tendencia_t)(iteracao % 3));
+}
+
+static void kernel_get_led_index(void)
+{
+    uint soma = 0;
+    for (uint y = 0; y < NUM_LINHAS; y++)
+        for (uint x = 0; x < NUM_COLUNAS; x++)
+            soma += getLEDIndex(x, y);
+    sumidouro += soma;
+}
+
+static void kernel_np_brilho(void)
+{
+    // O quadro anterior precisa terminar: avança o tempo virtual do envio
+    while (!npWriteDone())
+        bench_proximo_evento();
+    npSetAll(iteracao & 0xFF, 0x40, 0x80);
+    npWriteComBrilho8(0x80);
+}
+
+static void kernel_tendencia(void)
+{
+    sumidouro += tarefa3_analisa_tendencia(27.0f + (iteracao % 50) * 0.01f);
+}
+
+typedef struct
+{
+    const char *nome;
+    void (*kernel)(void);
+    uint iteracoes;
+} bench_kernel_t;
+
+static const bench_kernel_t kernels[] = {
+    {"draw_big_char", kernel_draw_big_char, 200000},
+    {"draw_big_char_desalinhado", kernel_draw_big_char_desalinhado, 200000},
+    {"draw_big_string", kernel_string_grande, 100000},
+    {"tarefa2_exibir_oled", kernel_quadro_oled, 5000},
+    {"getLEDIndex_matriz", kernel_get_led_index, 200000},
+    {"npWriteComBrilho8", kernel_np_brilho, 20000},
+    {"tarefa3_analisa_tendencia", kernel_tendencia, 200000},
+};
+
+static void bench_kernels(void)
+{
+    printf("%-28s %12s\n", "kernel", "ns/chamada");
+    for (uint k = 0; k < count_of(kernels); k++)
+    {
+        const bench_kernel_t *b = &kernels[k];
+        double melhor = INFINITY;
+        for (uint r = 0; r < BENCH_REPETICOES; r++)
+        {
+            uint64_t inicio = host_ns();
+            for (iteracao = 0; iteracao < b->iteracoes; iteracao++)
+                b->kernel();
+            double ns = (double)(host_ns() - inicio) / b->iteracoes;
+            if (ns < melhor)
+                melhor = ns;
+        }
+        printf("%-28s %12.1f\n", b->nome, melhor);
+        bench_registrar(b->nome, melhor, false);
+    }
+}
+
+// === Escalonador ===
+
+static uint64_t ns_em_tarefas; // Tempo de host dentro das funções das tarefas
+
+#define BENCH_MAX_TAREFAS 10
+
+// Entradas originais da tabela de 'tarefas.c', chamadas pelos trampolins
+static scheduler_entry_t entradas[BENCH_MAX_TAREFAS];
+
+/**
+ * @brief Roda a tarefa 'i' da tabela medindo o tempo de host gasto nela.
+ */
+static void bench_medir_tarefa(uint i)
+{
+    uint64_t inicio_ns = host_ns();
+    entradas[i]();
+    ns_em_tarefas += host_ns() - inicio_ns;
+}
+
+#define BENCH_TRAMPOLIM(i)                  \
+    static void bench_trampolim_##i(void)   \
+    {                                       \
+        bench_medir_tarefa(i);              \
+    }
+
+BENCH_TRAMPOLIM(0)
+BENCH_TRAMPOLIM(1)
+BENCH_TRAMPOLIM(2)
+BENCH_TRAMPOLIM(3)
+BENCH_TRAMPOLIM(4)
+BENCH_TRAMPOLIM(5)
+BENCH_TRAMPOLIM(6)
+BENCH_TRAMPOLIM(7)
+BENCH_TRAMPOLIM(8)
+BENCH_TRAMPOLIM(9)
+
+static const scheduler_entry_t trampolins[BENCH_MAX_TAREFAS] = {
+    bench_trampolim_0, bench_trampolim_1, bench_trampolim_2, bench_trampolim_3, bench_trampolim_4,
+    bench_trampolim_5, bench_trampolim_6, bench_trampolim_7, bench_trampolim_8, bench_trampolim_9,
+};
+_Static_assert(TASK_COUNT <= BENCH_MAX_TAREFAS, "um trampolim por tarefa da tabela");
+
+// Tabela de 'tarefas.c' com as entradas trocadas pelos trampolins (períodos, offsets,
+// orçamentos, prioridades e flags inalterados)
+static scheduler_task_t tabela_medida[TASK_COUNT];
+
+static uint64_t mdc(uint64_t a, uint64_t b)
+{
+    while (b)
+    {
+        uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static uint64_t hiperperiodo_ms(void)
+{
+    uint64_t h = 1;
+    for (uint i = 0; i < count_of(task_table); i++)
+        if (task_table[i].period_ms)
+            h = h / mdc(h, task_table[i].period_ms) * task_table[i].period_ms;
+
+    // Cobre ao menos um período da temperatura simulada
+    uint64_t minimo_ms = (uint64_t)(BENCH_TEMP_PERIODO_US / 1000);
+    return (minimo_ms + h - 1) / h * h;
+}
+
+static bool verboso; // '-v': mantém os printf das tarefas
+
+/**
+ * @brief Descarta a saída das tarefas durante a simulação, exceto com '-v'.
+ *
+ * @return Descritor do stdout original (-1 se nada foi redirecionado)
+ */
+static int bench_silenciar_stdout(void)
+{
+    if (verboso)
+        return -1;
+    fflush(stdout);
+    int original = dup(STDOUT_FILENO);
+    int nulo = open("/dev/null", O_WRONLY);
+    dup2(nulo, STDOUT_FILENO);
+    close(nulo);
+    return original;
+}
+
+static void bench_restaurar_stdout(int original)
+{
+    if (original < 0)
+        return;
+    fflush(stdout);
+    dup2(original, STDOUT_FILENO);
+    close(original);
+}
+
+static void bench_escalonador(uint hiperperiodos)
+{
+    uint64_t duracao_us = hiperperiodo_ms() * 1000 * hiperperiodos;
+    uint64_t fim = time_us_64() + duracao_us;
+    uint64_t despachos = 0, ns_despacho = 0;
+
+    for (uint i = 0; i < count_of(task_table); i++)
+    {
+        entradas[i] = task_table[i].entry;
+        tabela_medida[i] = task_table[i];
+        tabela_medida[i].entry = trampolins[i];
+    }
+
+    // Mesma partida de 'main()': só o ADC e o DMA estão prontos, a Tarefa 0 faz o resto
+    scheduler_init(tabela_medida, count_of(tabela_medida));
+    tarefas_conectar();
+    scheduler_start();
+    scheduler_release(TASK_BOOT);
+    scheduler_watchdog_enable();
+    int saida_tarefas = bench_silenciar_stdout();
+
+    uint64_t inicio_host = host_ns();
+    while (time_us_64() < fim)
+    {
+        sim_temperatura_c = BENCH_TEMP_MEDIA_C +
+                            BENCH_TEMP_AMPLITUDE_C * sin(2.0 * M_PI * time_us_64() / BENCH_TEMP_PERIODO_US);
+
+        uint64_t antes_tarefas = ns_em_tarefas;
+        uint64_t inicio = host_ns();
+        bool despachou = scheduler_dispatch();
+        uint64_t gasto = host_ns() - inicio;
+        if (despachou)
+        {
+            despachos++;
+            ns_despacho += gasto - (ns_em_tarefas - antes_tarefas);
+        }
+        else
+            scheduler_idle();
+    }
+    double segundos_host = (double)(host_ns() - inicio_host) / 1e9;
+    bench_restaurar_stdout(saida_tarefas);
+
+    printf("\n%u hiperperíodo(s) de %.1f s simulados em %.2f s de host (%lu despachos)\n",
+           hiperperiodos, hiperperiodo_ms() / 1000.0, segundos_host, (unsigned long)despachos);
+    printf("ADC: %lu amostras | I2C: %lu bytes | PIO: %lu palavras | ocioso: %.1f%%\n",
+           (unsigned long)sim_adc_amostras, (unsigned long)sim_i2c_bytes, (unsigned long)sim_pio_palavras,
+           100.0 * scheduler_idle_us() / time_us_64());
+
+    double overhead = despachos ? (double)ns_despacho / despachos : 0.0;
+    printf("overhead de despacho: %.1f ns\n\n", overhead);
+    bench_registrar("scheduler_dispatch_overhead", overhead, false);
+
+    printf("%-14s %8s %10s %10s %8s %8s %8s %12s\n",
+           "tarefa", "n", "max us", "p99 us", "perdas", "overruns", "descartes", "jitter máx us");
+    uint32_t perdas = 0, overruns = 0;
+    for (uint i = 0; i < count_of(task_table); i++)
+    {
+        const profiler_stats_t *p = profiler_stats(i);
+        const scheduler_task_stats_t *s = scheduler_stats(i);
+        printf("%-14s %8lu %10lu %10lu %8lu %8lu %8lu %12lu\n",
+               task_table[i].name,
+               (unsigned long)p->n,
+               (unsigned long)p->max_us,
+               (unsigned long)profiler_percentil_us(i, 99),
+               (unsigned long)s->deadline_misses,
+               (unsigned long)s->overruns,
+               (unsigned long)s->shed,
+               (unsigned long)s->jitter_max_us);
+        perdas += s->deadline_misses;
+        overruns += s->overruns;
+    }
+    printf("ciclos saudáveis: %lu | estouros do watchdog: %lu\n",
+           (unsigned long)scheduler_healthy_cycles(), (unsigned long)sim_watchdog_estouros);
+
+    bench_registrar("deadline_misses", perdas, true);
+    bench_registrar("overruns", overruns, true);
+    bench_registrar("watchdog_estouros", sim_watchdog_estouros, true);
+}
+
+// === CSV ===
+
+static void bench_gravar_csv(const char *caminho)
+{
+    FILE *f = fopen(caminho, "w");
+    if (!f)
+    {
+        perror(caminho);
+        exit(2);
+    }
+    fprintf(f, "nome,valor,unidade\n");
+    for (uint i = 0; i < n_resultados; i++)
+        fprintf(f, "%s,%.3f,%s\n", resultados[i].nome, resultados[i].valor,
+                resultados[i].contagem ? "contagem" : "ns");
+    fclose(f);
+}
+
+/**
+ * @brief Compara com um CSV anterior.
+ *
+ * @return Número de regressões
+ */
+static uint bench_comparar(const char *caminho, double tolerancia_pct)
+{
+    FILE *f = fopen(caminho, "r");
+    if (!f)
+    {
+        perror(caminho);
+        exit(2);
+    }
+
+    char linha[128];
+    uint regressoes = 0;
+    printf("\ncomparação com %s (tolerância %.0f%%):\n", caminho, tolerancia_pct);
+    while (fgets(linha, sizeof(linha), f))
+    {
+        char nome[48];
+        double base;
+        if (sscanf(linha, "%47[^,],%lf", nome, &base) != 2)
+            continue; // Cabeçalho
+
+        for (uint i = 0; i < n_resultados; i++)
+        {
+            const bench_resultado_t *r = &resultados[i];
+            if (strcmp(r->nome, nome) != 0)
+                continue;
+
+            bool piorou = r->contagem ? r->valor > base : r->valor > base * (1.0 + tolerancia_pct / 100.0);
+            printf("  %-28s %12.1f -> %12.1f%s\n", nome, base, r->valor, piorou ? "  REGRESSÃO" : "");
+            regressoes += piorou;
+        }
+    }
+    fclose(f);
+    return regressoes;
+}
+
+int main(int argc, char **argv)
+{
+    uint hiperperiodos = 1;
+    const char *saida = NULL, *base = NULL;
+    double tolerancia = BENCH_TOLERANCIA_PADRAO;
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:c:b:t:v")) != -1)
+    {
+        switch (opcao)
+        {
+        case 'n':
+            hiperperiodos = (uint)strtoul(optarg, NULL, 10);
+            break;
+        case 'c':
+            saida = optarg;
+            break;
+        case 'b':
+            base = optarg;
+            break;
+        case 't':
+            tolerancia = strtod(optarg, NULL);
+            break;
+        case 'v':
+            verboso = true;
+            break;
+        default:
+            fprintf(stderr, "uso: %s [-n hiperperiodos] [-c saida.csv] [-b base.csv] [-t tolerancia] [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup_aquisicao(); // OLED, NeoPixel e USB ficam com a Tarefa 0, como no firmware
+    sim_temperatura_c = BENCH_TEMP_MEDIA_C;
+
+    bench_escalonador(hiperperiodos);
+    printf("\n");
+    bench_kernels(); // Sobre o OLED e a NeoPixel já inicializados pela Tarefa 0
+
+    if (saida)
+        bench_gravar_csv(saida);
+    if (base && bench_comparar(base, tolerancia) > 0)
+        return 1;
+    return 0;
+}
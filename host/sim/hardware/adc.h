@@ -0,0 +1,25 @@
+#ifndef SIM_HARDWARE_ADC_H
+#define SIM_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+typedef struct
+{
+    volatile uint32_t cs, result, fcs, fifo, div, intr, inte, intf, ints;
+} adc_hw_t;
+
+// O endereço de 'fifo' identifica o ADC como origem de um canal DMA
+extern adc_hw_t *const adc_hw;
+
+void adc_init(void);
+void adc_set_temp_sensor_enabled(bool enable);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_set_round_robin(uint input_mask);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_fifo_drain(void);
+void adc_run(bool run);
+uint16_t adc_read(void);
+
+#endif // SIM_HARDWARE_ADC_H
@@ -0,0 +1,20 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index
+{
+    clk_ref = 4,
+    clk_sys = 5,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk)
+{
+    return clk == clk_adc || clk == clk_usb ? 48000000u : 125000000u;
+}
+
+#endif // SIM_HARDWARE_CLOCKS_H
@@ -0,0 +1,82 @@
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+#define NUM_DMA_CHANNELS 12
+
+#define DREQ_PIO0_TX0 0
+#define DREQ_PIO1_TX0 8
+#define DREQ_I2C0_TX 32
+#define DREQ_I2C1_TX 34
+#define DREQ_ADC 36
+#define DREQ_FORCE 0x3f
+
+#define DMA_SNIFF_CTRL_CALC_VALUE_SUM 0xf
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+typedef struct
+{
+    uint8_t size;
+    bool read_incr, write_incr, sniff;
+    uint8_t dreq;
+    uint8_t chain_to;
+} dma_channel_config;
+
+typedef struct
+{
+    volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+    volatile uint32_t al1_ctrl, al1_read_addr, al1_write_addr, al1_transfer_count_trig;
+} dma_channel_hw_t;
+
+typedef struct
+{
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+    volatile uint32_t intr, inte0, intf0, ints0, _pad, inte1, intf1, ints1;
+} dma_hw_t;
+
+// Só 'ints0'/'ints1' têm efeito: o simulador as preenche antes de chamar o handler
+extern dma_hw_t *const dma_hw;
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chan);
+void channel_config_set_sniff_enable(dma_channel_config *c, bool sniff_enable);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+
+void dma_channel_claim(uint channel);
+bool dma_channel_is_claimed(uint channel);
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count);
+void dma_channel_start(uint channel);
+void dma_start_channel_mask(uint32_t chan_mask);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+void dma_channel_set_irq1_enabled(uint channel, bool enabled);
+void dma_channel_acknowledge_irq0(uint channel);
+void dma_channel_acknowledge_irq1(uint channel);
+
+void dma_sniffer_enable(uint channel, uint mode, bool force_channel_enable);
+void dma_sniffer_set_data_accumulator(uint32_t seed_value);
+uint32_t dma_sniffer_get_data_accumulator(void);
+
+#endif // SIM_HARDWARE_DMA_H
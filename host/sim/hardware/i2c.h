@@ -0,0 +1,35 @@
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct
+{
+    volatile uint32_t tar, data_cmd, raw_intr_stat, clr_tx_abrt, enable, status;
+} i2c_hw_t;
+
+typedef struct i2c_inst
+{
+    i2c_hw_t hw;
+    uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x200u
+#define I2C_IC_ENABLE_ENABLE_BITS 0x1u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x40u
+#define I2C_IC_STATUS_ACTIVITY_BITS 0x1u
+#define I2C_IC_STATUS_TFE_BITS 0x4u
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c)
+{
+    return &i2c->hw;
+}
+
+#endif // SIM_HARDWARE_I2C_H
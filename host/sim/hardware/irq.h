@@ -0,0 +1,15 @@
+#ifndef SIM_HARDWARE_IRQ_H
+#define SIM_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define SIM_N_IRQS 32
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif // SIM_HARDWARE_IRQ_H
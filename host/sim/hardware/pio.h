@@ -0,0 +1,43 @@
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+#define NUM_PIOS 2
+#define NUM_PIO_STATE_MACHINES 4
+#define SIM_PIO_MEMORIA 32 // Instruções por bloco
+
+typedef struct pio_hw
+{
+    volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+    uint8_t indice;
+    uint8_t sm_ocupadas;
+    uint8_t memoria_usada;
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t pio0_hw_inst, pio1_hw_inst;
+#define pio0 (&pio0_hw_inst)
+#define pio1 (&pio1_hw_inst)
+
+typedef struct pio_program
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_unclaim(PIO pio, uint sm);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx)
+{
+    (void)is_tx;
+    return (pio->indice ? 8 : 0) + sm;
+}
+
+#endif // SIM_HARDWARE_PIO_H
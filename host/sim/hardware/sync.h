@@ -0,0 +1,19 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Máscara global de interrupções: as pendentes são atendidas em 'restore_interrupts()'
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+// Avança o tempo virtual até o próximo evento (acorda mesmo com as interrupções mascaradas)
+void __wfi(void);
+
+static inline void __wfe(void) { __wfi(); }
+static inline void __sev(void) {}
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __compiler_memory_barrier(void) { __atomic_signal_fence(__ATOMIC_SEQ_CST); }
+
+#endif // SIM_HARDWARE_SYNC_H
@@ -0,0 +1,11 @@
+#ifndef SIM_HARDWARE_WATCHDOG_H
+#define SIM_HARDWARE_WATCHDOG_H
+
+#include "pico/stdlib.h"
+
+// Um estouro é contado em 'sim_watchdog_estouros' em vez de reiniciar
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+
+#endif // SIM_HARDWARE_WATCHDOG_H
@@ -0,0 +1,522 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/perifericos.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Modelos de ADC, DMA, I2C e PIO do build de simulação.
+ *
+ *      Um canal DMA disparado agenda o próprio fim para
+ *      'transferências × período do DREQ' e, nesse instante,
+ *      copia o bloco inteiro: amostras do ADC quando a origem
+ *      é 'adc_hw->fifo', contagem de bytes/palavras quando o
+ *      destino é um I2C ou uma máquina PIO, memcpy nos demais
+ *      casos. Em seguida sinaliza DMA_IRQ_0/1 conforme os
+ *      bits de 'inte0'/'inte1' do canal e segue o chain_to.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "sim.h"
+#include "sim_interno.h"
+
+#define ADC_CLOCK_HZ 48000000.0
+#define ADC_CICLOS_MIN 96
+#define ADC_SENSOR 4
+#define I2C_BITS_POR_BYTE 9    // 8 bits + ACK
+#define WS2812_US_POR_PALAVRA 30 // 24 bits a 800 kHz
+
+volatile float sim_temperatura_c = 27.0f;
+uint64_t sim_adc_amostras;
+uint64_t sim_i2c_bytes;
+uint64_t sim_pio_palavras;
+
+// === ADC ===
+
+static adc_hw_t adc_regs;
+adc_hw_t *const adc_hw = &adc_regs;
+
+static struct
+{
+    uint entrada;
+    uint round_robin;
+    double ciclos; // clk_adc por conversão
+    bool rodando;
+    uint32_t ruido; // LCG
+    float temperatura; // Temperatura do código em cache
+    int codigo_sensor;
+} adc = {.ciclos = ADC_CICLOS_MIN, .temperatura = NAN};
+
+void adc_init(void)
+{
+    adc.entrada = 0;
+    adc.round_robin = 0;
+    adc.ciclos = ADC_CICLOS_MIN;
+    adc.ruido = 1;
+}
+
+void adc_set_temp_sensor_enabled(bool enable)
+{
+    (void)enable;
+}
+
+void adc_gpio_init(uint gpio)
+{
+    (void)gpio;
+}
+
+void adc_select_input(uint input)
+{
+    adc.entrada = input;
+}
+
+void adc_set_round_robin(uint input_mask)
+{
+    adc.round_robin = input_mask;
+}
+
+void adc_set_clkdiv(float clkdiv)
+{
+    adc.ciclos = clkdiv < ADC_CICLOS_MIN - 1 ? ADC_CICLOS_MIN : 1.0 + clkdiv;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift)
+{
+    (void)en;
+    (void)dreq_en;
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+}
+
+void adc_fifo_drain(void)
+{
+}
+
+void adc_run(bool run)
+{
+    adc.rodando = run;
+}
+
+/**
+ * @brief Próxima conversão: sensor interno a 'sim_temperatura_c', demais entradas a meia escala.
+ */
+static uint16_t adc_converter(void)
+{
+    uint entrada = adc.entrada;
+    if (adc.round_robin)
+    {
+        // Próxima entrada da máscara, em ordem crescente
+        do
+            adc.entrada = (adc.entrada + 1) % 5;
+        while (!(adc.round_robin & (1u << adc.entrada)));
+    }
+
+    if (adc.temperatura != sim_temperatura_c)
+    {
+        // Inverso da conversão da Tarefa 1, recalculado só quando a temperatura muda
+        adc.temperatura = sim_temperatura_c;
+        adc.codigo_sensor = (int)lround((0.706 - (adc.temperatura - 27.0) * 0.001721) * 4096.0 / 3.3);
+    }
+
+    adc.ruido = adc.ruido * 1103515245u + 12345u;
+    int ruido = (int)((adc.ruido >> 16) % 5) - 2;
+    int codigo = (entrada == ADC_SENSOR ? adc.codigo_sensor : 2048) + ruido;
+    sim_adc_amostras++;
+    return (uint16_t)(codigo < 0 ? 0 : codigo > 4095 ? 4095 : codigo);
+}
+
+uint16_t adc_read(void)
+{
+    sim_avancar_us((uint64_t)(adc.ciclos / ADC_CLOCK_HZ * 1e6));
+    return adc_converter();
+}
+
+// === I2C ===
+
+i2c_inst_t i2c0_inst = {.hw = {.status = I2C_IC_STATUS_TFE_BITS, .enable = I2C_IC_ENABLE_ENABLE_BITS}};
+i2c_inst_t i2c1_inst = {.hw = {.status = I2C_IC_STATUS_TFE_BITS, .enable = I2C_IC_ENABLE_ENABLE_BITS}};
+
+static double i2c_us_por_byte(const i2c_inst_t *i2c)
+{
+    return (double)I2C_BITS_POR_BYTE * 1e6 / (i2c->baudrate ? i2c->baudrate : 100000);
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)addr;
+    (void)src;
+    (void)nostop;
+    sim_i2c_bytes += len;
+    sim_avancar_us((uint64_t)((len + 1) * i2c_us_por_byte(i2c))); // + endereço
+    return (int)len;
+}
+
+// === PIO ===
+
+pio_hw_t pio0_hw_inst = {.indice = 0};
+pio_hw_t pio1_hw_inst = {.indice = 1};
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program)
+{
+    return pio->memoria_usada + program->length <= SIM_PIO_MEMORIA;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program)
+{
+    assert(pio_can_add_program(pio, program));
+    uint offset = SIM_PIO_MEMORIA - pio->memoria_usada - program->length; // Carregado do fim, como no SDK
+    pio->memoria_usada += program->length;
+    return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required)
+{
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++)
+    {
+        if (!(pio->sm_ocupadas & (1u << sm)))
+        {
+            pio->sm_ocupadas |= 1u << sm;
+            return (int)sm;
+        }
+    }
+    assert(!required);
+    return -1;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm)
+{
+    pio->sm_ocupadas &= ~(1u << sm);
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled)
+{
+    (void)pio;
+    (void)sm;
+    (void)enabled;
+}
+
+// === DMA ===
+
+static dma_hw_t dma_regs;
+dma_hw_t *const dma_hw = &dma_regs;
+
+typedef struct
+{
+    dma_channel_config cfg;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint32_t contagem;
+    bool ocupado;
+    bool reservado;
+    int evento;
+} sim_dma_canal_t;
+
+static sim_dma_canal_t canais[NUM_DMA_CHANNELS];
+
+static struct
+{
+    uint canal;
+    bool ativo;
+    uint32_t acumulador;
+} sniffer;
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    dma_channel_config c = {
+        .size = DMA_SIZE_32,
+        .read_incr = true,
+        .write_incr = false,
+        .dreq = DREQ_FORCE,
+        .chain_to = (uint8_t)channel, // chain_to a si mesmo = sem encadeamento
+    };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->read_incr = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->write_incr = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    c->dreq = (uint8_t)dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chan)
+{
+    c->chain_to = (uint8_t)chan;
+}
+
+void channel_config_set_sniff_enable(dma_channel_config *c, bool sniff_enable)
+{
+    c->sniff = sniff_enable;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    (void)c;
+    (void)write;
+    (void)size_bits;
+    fprintf(stderr, "sim: DMA em anel não é simulado (TAREFA1_STREAMING)\n");
+    abort();
+}
+
+void dma_channel_claim(uint channel)
+{
+    assert(!canais[channel].reservado);
+    canais[channel].reservado = true;
+}
+
+bool dma_channel_is_claimed(uint channel)
+{
+    return canais[channel].reservado;
+}
+
+int dma_claim_unused_channel(bool required)
+{
+    // Menor canal livre, como no SDK (os da Tarefa 1 são reservados antes, em 'setup.c')
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        if (!canais[ch].reservado)
+        {
+            canais[ch].reservado = true;
+            return (int)ch;
+        }
+    }
+    assert(!required);
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel)
+{
+    canais[channel].reservado = false;
+}
+
+/**
+ * @brief Período de uma transferência conforme o DREQ, em µs.
+ */
+static double dma_periodo_us(const dma_channel_config *c)
+{
+    if (c->dreq == DREQ_ADC)
+        return adc.ciclos / ADC_CLOCK_HZ * 1e6;
+    if (c->dreq == DREQ_I2C0_TX)
+        return i2c_us_por_byte(i2c0);
+    if (c->dreq == DREQ_I2C1_TX)
+        return i2c_us_por_byte(i2c1);
+    if (c->dreq < DREQ_I2C0_TX)
+        return WS2812_US_POR_PALAVRA;
+    return 0.0; // Memória → memória: instantâneo na escala do simulador
+}
+
+static void dma_disparar(uint ch);
+
+/**
+ * @brief Fim da transferência: move os dados, sinaliza a interrupção e segue o encadeamento.
+ */
+static void dma_concluir(void *arg)
+{
+    uint ch = (uint)(uintptr_t)arg;
+    sim_dma_canal_t *c = &canais[ch];
+    uint tamanho = 1u << c->cfg.size;
+    uint8_t *escrita = (uint8_t *)c->escrita;
+    const uint8_t *leitura = (const uint8_t *)c->leitura;
+
+    for (uint32_t i = 0; i < c->contagem; i++)
+    {
+        uint32_t dado = 0;
+        if (leitura == (const uint8_t *)&adc_hw->fifo)
+            dado = adc_converter();
+        else
+            memcpy(&dado, leitura, tamanho);
+
+        if (c->cfg.sniff && sniffer.ativo && sniffer.canal == ch)
+            sniffer.acumulador += dado;
+
+        if (escrita == (uint8_t *)&i2c0->hw.data_cmd || escrita == (uint8_t *)&i2c1->hw.data_cmd)
+            sim_i2c_bytes++;
+        else if (escrita >= (uint8_t *)pio0->txf && escrita < (uint8_t *)(pio0->txf + NUM_PIO_STATE_MACHINES))
+            sim_pio_palavras++;
+        else if (escrita >= (uint8_t *)pio1->txf && escrita < (uint8_t *)(pio1->txf + NUM_PIO_STATE_MACHINES))
+            sim_pio_palavras++;
+        else
+            memcpy(escrita, &dado, tamanho);
+
+        if (c->cfg.read_incr)
+            leitura += tamanho;
+        if (c->cfg.write_incr)
+            escrita += tamanho;
+    }
+
+    c->escrita = escrita;
+    c->leitura = leitura;
+    c->ocupado = false;
+    c->evento = 0;
+
+    if (dma_hw->inte0 & (1u << ch))
+    {
+        dma_hw->ints0 |= 1u << ch;
+        sim_irq_sinalizar(DMA_IRQ_0);
+        dma_hw->ints0 &= ~(1u << ch); // O handler "limpa" escrevendo 1
+    }
+    if (dma_hw->inte1 & (1u << ch))
+    {
+        dma_hw->ints1 |= 1u << ch;
+        sim_irq_sinalizar(DMA_IRQ_1);
+        dma_hw->ints1 &= ~(1u << ch);
+    }
+    if (c->cfg.chain_to != ch)
+        dma_disparar(c->cfg.chain_to);
+}
+
+static void dma_disparar(uint ch)
+{
+    sim_dma_canal_t *c = &canais[ch];
+    assert(!c->ocupado);
+    c->ocupado = true;
+    uint64_t duracao = (uint64_t)(c->contagem * dma_periodo_us(&c->cfg) + 0.5);
+    c->evento = sim_agendar(time_us_64() + duracao, dma_concluir, (void *)(uintptr_t)ch);
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    sim_dma_canal_t *c = &canais[channel];
+    c->cfg = *config;
+    c->escrita = write_addr;
+    c->leitura = read_addr;
+    c->contagem = transfer_count;
+    if (trigger)
+        dma_disparar(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    canais[channel].leitura = read_addr;
+    if (trigger)
+        dma_disparar(channel);
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger)
+{
+    canais[channel].escrita = write_addr;
+    if (trigger)
+        dma_disparar(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger)
+{
+    canais[channel].contagem = trans_count;
+    if (trigger)
+        dma_disparar(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count)
+{
+    canais[channel].leitura = read_addr;
+    canais[channel].contagem = transfer_count;
+    dma_disparar(channel);
+}
+
+void dma_channel_start(uint channel)
+{
+    dma_disparar(channel);
+}
+
+void dma_start_channel_mask(uint32_t chan_mask)
+{
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+        if (chan_mask & (1u << ch))
+            dma_disparar(ch);
+}
+
+void dma_channel_abort(uint channel)
+{
+    sim_dma_canal_t *c = &canais[channel];
+    if (c->ocupado)
+        sim_cancelar(c->evento);
+    c->ocupado = false;
+    c->evento = 0;
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+    return canais[channel].ocupado;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+    while (canais[channel].ocupado)
+        __wfi();
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+    if (enabled)
+        dma_hw->inte0 |= 1u << channel;
+    else
+        dma_hw->inte0 &= ~(1u << channel);
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled)
+{
+    if (enabled)
+        dma_hw->inte1 |= 1u << channel;
+    else
+        dma_hw->inte1 &= ~(1u << channel);
+}
+
+void dma_channel_acknowledge_irq0(uint channel)
+{
+    (void)channel;
+}
+
+void dma_channel_acknowledge_irq1(uint channel)
+{
+    (void)channel;
+}
+
+void dma_sniffer_enable(uint channel, uint mode, bool force_channel_enable)
+{
+    assert(mode == DMA_SNIFF_CTRL_CALC_VALUE_SUM);
+    (void)force_channel_enable;
+    sniffer.canal = channel;
+    sniffer.ativo = true;
+}
+
+void dma_sniffer_set_data_accumulator(uint32_t seed_value)
+{
+    sniffer.acumulador = seed_value;
+}
+
+uint32_t dma_sniffer_get_data_accumulator(void)
+{
+    return sniffer.acumulador;
+}
@@ -0,0 +1,11 @@
+#ifndef SIM_PICO_STDIO_USB_H
+#define SIM_PICO_STDIO_USB_H
+
+#include "pico/stdlib.h"
+
+static inline bool stdio_usb_connected(void)
+{
+    return true;
+}
+
+#endif // SIM_PICO_STDIO_USB_H
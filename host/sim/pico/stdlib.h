@@ -0,0 +1,145 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/pico/stdlib.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Subconjunto do 'pico/stdlib.h' do Pico SDK para o build
+ *      de simulação no host. O tempo é virtual ('sim.c'):
+ *      só avança nas esperas ('__wfi()', 'sleep_*',
+ *      'tight_loop_contents()'), de forma determinística.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x##u
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+#define __unused __attribute__((unused))
+
+// Tempo
+typedef uint64_t absolute_time_t;
+
+#define nil_time ((absolute_time_t)0)
+#define at_the_end_of_time ((absolute_time_t)INT64_MAX)
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to - from);
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us)
+{
+    return t + us;
+}
+
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms)
+{
+    return t + (uint64_t)ms * 1000;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us)
+{
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return time_us_64() + (uint64_t)ms * 1000;
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t)
+{
+    return t;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t)(t / 1000);
+}
+
+static inline bool time_reached(absolute_time_t t)
+{
+    return time_us_64() >= t;
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+void busy_wait_us(uint64_t us);
+void tight_loop_contents(void);
+
+// Alarmes
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t id);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer
+{
+    int64_t delay_us;
+    void *user_data;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+// GPIO e stdio (sem efeito no host)
+enum gpio_function
+{
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+};
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(uint gpio, bool value) { (void)gpio; (void)value; }
+
+static inline bool stdio_init_all(void)
+{
+    return true;
+}
+
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_OK 0
+
+int getchar_timeout_us(uint32_t timeout_us);
+int putchar_raw(int c);
+
+#include "hardware/sync.h"
+
+#endif // SIM_PICO_STDLIB_H
@@ -0,0 +1,378 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/sim.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Núcleo do simulador: tempo virtual, fila de eventos,
+ *      alarmes, interrupções e watchdog.
+ *
+ *      Cada evento é uma ação com instante de disparo. Os
+ *      alarmes do SDK e os fins de transferência DMA (em
+ *      'perifericos.c') entram na mesma fila, que é atendida
+ *      em ordem de tempo; empates seguem a ordem de inserção.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "sim.h"
+#include "sim_interno.h"
+
+#define SIM_MAX_EVENTOS 64
+
+typedef struct
+{
+    uint64_t quando;
+    uint64_t ordem;  // Desempate estável
+    sim_acao_t acao;
+    void *arg;
+    int id;          // 0 = posição livre
+} sim_evento_t;
+
+static uint64_t agora_us;
+static sim_evento_t eventos[SIM_MAX_EVENTOS];
+static uint64_t proxima_ordem;
+static int proximo_id = 1;
+
+// Interrupções
+static bool mascaradas;
+static irq_handler_t handlers[SIM_N_IRQS];
+static bool habilitadas[SIM_N_IRQS];
+static uint32_t irqs_pendentes;
+
+// Ações vencidas com as interrupções mascaradas (atendidas em ordem)
+static sim_evento_t pendentes[SIM_MAX_EVENTOS];
+static uint n_pendentes;
+
+// Watchdog
+static uint64_t watchdog_prazo_us;
+static uint64_t watchdog_limite;
+uint32_t sim_watchdog_estouros;
+
+uint64_t time_us_64(void)
+{
+    return agora_us;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)agora_us;
+}
+
+int sim_agendar(uint64_t quando, sim_acao_t acao, void *arg)
+{
+    for (uint i = 0; i < SIM_MAX_EVENTOS; i++)
+    {
+        if (eventos[i].id == 0)
+        {
+            eventos[i] = (sim_evento_t){quando, proxima_ordem++, acao, arg, proximo_id++};
+            return eventos[i].id;
+        }
+    }
+    fprintf(stderr, "sim: fila de eventos cheia\n");
+    abort();
+}
+
+bool sim_cancelar(int id)
+{
+    for (uint i = 0; i < SIM_MAX_EVENTOS; i++)
+    {
+        if (eventos[i].id == id)
+        {
+            eventos[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int sim_evento_mais_cedo(void)
+{
+    int melhor = -1;
+    for (uint i = 0; i < SIM_MAX_EVENTOS; i++)
+    {
+        if (eventos[i].id == 0)
+            continue;
+        if (melhor < 0 || eventos[i].quando < eventos[melhor].quando ||
+            (eventos[i].quando == eventos[melhor].quando && eventos[i].ordem < eventos[melhor].ordem))
+            melhor = (int)i;
+    }
+    return melhor;
+}
+
+uint64_t sim_proximo_evento_us(void)
+{
+    int i = sim_evento_mais_cedo();
+    return i < 0 ? UINT64_MAX : eventos[i].quando;
+}
+
+void sim_irq_sinalizar(uint num)
+{
+    irqs_pendentes |= 1u << num;
+    if (!mascaradas)
+        sim_atender_pendentes();
+}
+
+void sim_atender_pendentes(void)
+{
+    // O atendimento acontece com as interrupções mascaradas, como num handler
+    mascaradas = true;
+    for (uint i = 0; i < n_pendentes; i++)
+        pendentes[i].acao(pendentes[i].arg);
+    n_pendentes = 0;
+    while (irqs_pendentes)
+    {
+        uint num = __builtin_ctz(irqs_pendentes);
+        irqs_pendentes &= ~(1u << num);
+        if (habilitadas[num] && handlers[num])
+            handlers[num]();
+    }
+    mascaradas = false;
+}
+
+/**
+ * @brief Dispara o evento mais cedo (se vencer até 'limite'), avançando o tempo até ele.
+ *
+ * @return false se nenhum evento vence até 'limite'
+ */
+static bool sim_disparar_proximo(uint64_t limite)
+{
+    int i = sim_evento_mais_cedo();
+    if (i < 0 || eventos[i].quando > limite)
+        return false;
+
+    sim_evento_t ev = eventos[i];
+    eventos[i].id = 0;
+    if (ev.quando > agora_us)
+        agora_us = ev.quando;
+
+    if (watchdog_prazo_us && agora_us > watchdog_limite)
+    {
+        sim_watchdog_estouros++;
+        watchdog_limite = agora_us + watchdog_prazo_us; // Sem reset: apenas conta
+    }
+
+    if (mascaradas)
+    {
+        if (n_pendentes == SIM_MAX_EVENTOS)
+        {
+            fprintf(stderr, "sim: eventos pendentes demais com interrupções mascaradas\n");
+            abort();
+        }
+        pendentes[n_pendentes++] = ev;
+    }
+    else
+    {
+        mascaradas = true;
+        ev.acao(ev.arg);
+        mascaradas = false;
+        sim_atender_pendentes();
+    }
+    return true;
+}
+
+void sim_avancar_us(uint64_t us)
+{
+    uint64_t alvo = agora_us + us;
+    while (sim_disparar_proximo(alvo))
+        ;
+    agora_us = alvo;
+}
+
+void __wfi(void)
+{
+    if (n_pendentes || irqs_pendentes)
+        return; // Há interrupção pendente: não dorme
+    if (!sim_disparar_proximo(UINT64_MAX))
+    {
+        fprintf(stderr, "sim: __wfi() sem eventos agendados (deadlock)\n");
+        abort();
+    }
+}
+
+uint32_t save_and_disable_interrupts(void)
+{
+    uint32_t anterior = mascaradas;
+    mascaradas = true;
+    return anterior;
+}
+
+void restore_interrupts(uint32_t status)
+{
+    mascaradas = status;
+    if (!mascaradas && (n_pendentes || irqs_pendentes))
+        sim_atender_pendentes();
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler)
+{
+    assert(num < SIM_N_IRQS && handlers[num] == NULL);
+    handlers[num] = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled)
+{
+    habilitadas[num] = enabled;
+}
+
+void sleep_us(uint64_t us)
+{
+    sim_avancar_us(us);
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sim_avancar_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t t)
+{
+    if (t > agora_us)
+        sim_avancar_us(t - agora_us);
+}
+
+void busy_wait_us(uint64_t us)
+{
+    sim_avancar_us(us);
+}
+
+void tight_loop_contents(void)
+{
+    sim_avancar_us(1);
+}
+
+// === Alarmes ===
+
+typedef struct
+{
+    alarm_callback_t callback;
+    void *user_data;
+    uint64_t alvo;
+    int id; // Evento agendado (muda a cada reagendamento)
+    int id_publico;
+} sim_alarme_t;
+
+#define SIM_MAX_ALARMES 40
+
+static sim_alarme_t alarmes[SIM_MAX_ALARMES];
+
+static void sim_alarme_disparar(void *arg)
+{
+    sim_alarme_t *a = arg;
+    int64_t r = a->callback(a->id_publico, a->user_data);
+
+    if (r == 0 || a->id == 0)
+    {
+        a->id = 0; // Não repete (ou foi cancelado no callback)
+        return;
+    }
+    // Negativo: relativo ao disparo previsto; positivo: ao retorno do callback
+    a->alvo = r < 0 ? a->alvo + (uint64_t)(-r) : agora_us + (uint64_t)r;
+    a->id = sim_agendar(a->alvo, sim_alarme_disparar, a);
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    for (uint i = 0; i < SIM_MAX_ALARMES; i++)
+    {
+        sim_alarme_t *a = &alarmes[i];
+        if (a->id != 0)
+            continue;
+        if (time <= agora_us && !fire_if_past)
+            return 0;
+        a->callback = callback;
+        a->user_data = user_data;
+        a->alvo = time;
+        a->id_publico = (int)i + 1;
+        a->id = sim_agendar(time, sim_alarme_disparar, a);
+        return a->id_publico;
+    }
+    return -1;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_at(agora_us + us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_at(agora_us + (uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t id)
+{
+    if (id <= 0 || id > SIM_MAX_ALARMES || alarmes[id - 1].id == 0)
+        return false;
+    sim_cancelar(alarmes[id - 1].id);
+    alarmes[id - 1].id = 0;
+    return true;
+}
+
+static int64_t sim_repeating_callback(alarm_id_t id, void *user_data)
+{
+    repeating_timer_t *rt = user_data;
+    (void)id;
+    if (!rt->callback(rt))
+        return 0;
+    return rt->delay_us; // Negativo: taxa fixa; positivo: intervalo após o callback
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out)
+{
+    uint64_t atraso = (uint64_t)(delay_us < 0 ? -delay_us : delay_us);
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = add_alarm_in_us(atraso, sim_repeating_callback, out, true);
+    return out->alarm_id > 0;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out)
+{
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer)
+{
+    return cancel_alarm(timer->alarm_id);
+}
+
+// === Watchdog ===
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug)
+{
+    (void)pause_on_debug;
+    watchdog_prazo_us = (uint64_t)delay_ms * 1000;
+    watchdog_limite = agora_us + watchdog_prazo_us;
+}
+
+void watchdog_update(void)
+{
+    watchdog_limite = agora_us + watchdog_prazo_us;
+}
+
+bool watchdog_caused_reboot(void)
+{
+    return false;
+}
+
+// === stdio ===
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    (void)timeout_us;
+    return PICO_ERROR_TIMEOUT;
+}
+
+int putchar_raw(int c)
+{
+    return c; // O fluxo binário (telemetria, histórico) é descartado
+}
@@ -0,0 +1,64 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/sim.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Controle do simulador usado pelo build de host.
+ *
+ *      O tempo virtual começa em zero e só avança quando o
+ *      firmware espera: '__wfi()' salta para o próximo evento
+ *      (alarme ou fim de transferência DMA), 'sleep_*' e
+ *      'busy_wait_us' avançam o tempo pedido e
+ *      'tight_loop_contents()' avança 1 µs. O trabalho de CPU
+ *      das tarefas não consome tempo virtual: as medidas de
+ *      tempo de processamento vêm do relógio do host.
+ *
+ *      Os eventos que vencem com as interrupções mascaradas
+ *      ficam pendentes até 'restore_interrupts()', como no
+ *      NVIC.
+ *
+ *      Periféricos modelados:
+ *          - ADC: 96 ciclos de 48 MHz por conversão (ou o
+ *            divisor programado), códigos do sensor interno
+ *            para 'sim_temperatura_c' com ruído de ±2 LSB;
+ *          - DMA: o bloco inteiro é copiado no fim da
+ *            transferência, com a duração dada pelo DREQ
+ *            (ADC, I2C a 9 bits por byte, PIO a 30 µs por LED);
+ *          - I2C e PIO: contam bytes e palavras enviados.
+ *
+ *      A aquisição livre da Tarefa 1 (TAREFA1_PING_PONG e
+ *      TAREFA1_STREAMING) e o modo dual-core não são
+ *      simulados: só a aquisição por blocos.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Temperatura vista pelo sensor interno do ADC (pode variar durante a simulação)
+extern volatile float sim_temperatura_c;
+
+// Contadores dos periféricos
+extern uint64_t sim_adc_amostras;
+extern uint64_t sim_i2c_bytes;
+extern uint64_t sim_pio_palavras;
+extern uint32_t sim_watchdog_estouros;
+
+/**
+ * @brief Avança o tempo virtual, atendendo os eventos que vencerem no caminho.
+ */
+void sim_avancar_us(uint64_t us);
+
+/**
+ * @brief Tempo virtual do próximo evento (UINT64_MAX se não houver).
+ */
+uint64_t sim_proximo_evento_us(void);
+
+#endif // SIM_H
@@ -0,0 +1,39 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/sim_interno.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface entre o núcleo do simulador ('sim.c') e os
+ *      periféricos ('perifericos.c').
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SIM_INTERNO_H
+#define SIM_INTERNO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef void (*sim_acao_t)(void *arg);
+
+/**
+ * @brief Agenda uma ação para o instante virtual 'quando' (contexto de interrupção).
+ *
+ * @return Identificador do evento, para 'sim_cancelar()'
+ */
+int sim_agendar(uint64_t quando, sim_acao_t acao, void *arg);
+
+bool sim_cancelar(int id);
+
+/**
+ * @brief Marca a linha de interrupção 'num' como pendente; o handler roda quando desmascarada.
+ */
+void sim_irq_sinalizar(unsigned num);
+
+void sim_atender_pendentes(void);
+
+#endif // SIM_INTERNO_H
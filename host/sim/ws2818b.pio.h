@@ -0,0 +1,38 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: host/sim/ws2818b.pio.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Substitui o cabeçalho gerado pelo pioasm no build de
+ *      simulação: o programa ocupa a memória do bloco, mas a
+ *      temporização dos LEDs é modelada pelo DMA do simulador
+ *      (24 bits a 800 kHz por palavra).
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SIM_WS2818B_PIO_H
+#define SIM_WS2818B_PIO_H
+
+#include "hardware/pio.h"
+
+static const uint16_t ws2818b_program_instructions[4] = {0};
+
+static const pio_program_t ws2818b_program = {
+    .instructions = ws2818b_program_instructions,
+    .length = 4,
+    .origin = -1,
+};
+
+static inline void ws2818b_program_init(PIO pio, uint sm, uint offset, uint pin, float freq)
+{
+    (void)offset;
+    (void)pin;
+    (void)freq;
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif // SIM_WS2818B_PIO_H
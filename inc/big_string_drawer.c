@@ -1,36 +1,44 @@
-#include "font_big_logo.h"
+#include "font_big_columns.h" // gerado no build a partir de font_big_logo_data.c
 #include "draw_big_char.h"
+#include "big_string_drawer.h"
 #include <stddef.h>
 
+// Glifo e avanço horizontal de cada caractere, indexados diretamente pelo código ASCII
+typedef struct {
+    const uint8_t *columns; // NULL = caractere sem glifo (apenas avança)
+    uint8_t width;
+} big_glyph_t;
+
+static const big_glyph_t big_glyphs[128] = {
+    ['0'] = {big_digit_0_cols, 16},
+    ['1'] = {big_digit_1_cols, 16},
+    ['2'] = {big_digit_2_cols, 16},
+    ['3'] = {big_digit_3_cols, 16},
+    ['4'] = {big_digit_4_cols, 16},
+    ['5'] = {big_digit_5_cols, 16},
+    ['6'] = {big_digit_6_cols, 16},
+    ['7'] = {big_digit_7_cols, 16},
+    ['8'] = {big_digit_8_cols, 16},
+    ['9'] = {big_digit_9_cols, 16},
+    ['+'] = {big_char_plus_cols, 16},
+    ['-'] = {big_char_minus_cols, 16},
+    ['.'] = {big_char_dot_cols, 8},
+    ['o'] = {big_char_degree_cols, 8},
+    ['C'] = {big_char_C_cols, 16},
+};
+
+static inline const big_glyph_t *get_big_glyph(char c) {
+    static const big_glyph_t sem_glifo = {NULL, 16};
+    unsigned char code = (unsigned char)c;
+    return (code < 128 && big_glyphs[code].width) ? &big_glyphs[code] : &sem_glifo;
+}
+
 const uint8_t* get_big_bitmap(char c) {
-    switch (c) {
-        case '0': return big_digit_0;
-        case '1': return big_digit_1;
-        case '2': return big_digit_2;
-        case '3': return big_digit_3;
-        case '4': return big_digit_4;
-        case '5': return big_digit_5;
-        case '6': return big_digit_6;
-        case '7': return big_digit_7;
-        case '8': return big_digit_8;
-        case '9': return big_digit_9;
-        case '+': return big_char_plus;
-        case '-': return big_char_minus;
-        case '.': return big_char_dot;
-        case 'o': return big_char_degree;
-        case 'C': return big_char_C;
-        default: return NULL;
-    }
+    return get_big_glyph(c)->columns;
 }
 
 int get_char_width(char c) {
-    switch (c) {
-        case '.':
-        case 'o':
-            return 8;
-        default:
-            return 16;
-    }
+    return get_big_glyph(c)->width;
 }
 
 int calc_string_width(const char *str) {
@@ -42,15 +50,34 @@ int calc_string_width(const char *str) {
     return width;
 }
 
-void draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str) {
+int draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str) {
     int width = calc_string_width(str);
     int x = 128 - width;
+    int start = x;
     while (*str) {
-        const uint8_t *bitmap = get_big_bitmap(*str);
-        if (bitmap) {
-            draw_big_char(ssd, x, y, bitmap);
+        const big_glyph_t *glyph = get_big_glyph(*str);
+        if (glyph->columns) {
+            draw_big_char(ssd, x, y, glyph->columns);
         }
-        x += get_char_width(*str);
+        x += glyph->width;
         str++;
     }
+    return start;
+}
+
+void clear_big_string_left(uint8_t *ssd, int y, int x_end) {
+    if (x_end <= 0) {
+        return;
+    }
+
+    struct render_area left = {
+        .start_column = 0,
+        .end_column = x_end - 1,
+        .start_page = y / 8,
+        .end_page = (y + BIG_FONT_INK_PAGES * 8 - 1) / 8,
+    };
+    if (left.end_page >= ssd1306_n_pages) {
+        left.end_page = ssd1306_n_pages - 1;
+    }
+    ssd1306_clear_area(ssd, &left);
 }
@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 
-void draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str);
+// Desenha a string alinhada à direita e retorna a coluna onde ela começa
+int draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str);
+
+// Apaga as colunas [0, x_end) das páginas da fonte grande (sobras de uma string mais larga)
+void clear_big_string_left(uint8_t *ssd, int y, int x_end);
 
 #endif
\ No newline at end of file
@@ -6,5 +6,6 @@
 void mostrar_valor_grande(uint8_t *ssd, float valor, int y) {
     char buffer[16];
     snprintf(buffer, sizeof(buffer), "%+.1foC", valor);
-    draw_big_string_aligned_right(ssd, y, buffer);
+    int x = draw_big_string_aligned_right(ssd, y, buffer);
+    clear_big_string_left(ssd, y, x); // Sobras de um valor anterior mais largo
 }
\ No newline at end of file
@@ -4,15 +4,16 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "ssd1306.h"
+#include "font_big_columns.h" // BIG_FONT_INK_PAGES
 
-// Desenha um caractere grande no buffer ssd[] a partir de bitmap de 64 bytes
-void draw_big_char(uint8_t *ssd, int x, int y, const uint8_t *bitmap) {
-    for (int row = 0; row < 32; row++) {
-        for (int col = 0; col < 16; col++) {
-            int byte_index = (row * 2) + (col / 8);
-            bool pixel = (bitmap[byte_index] >> (7 - (col % 8))) & 0x01;
-            ssd1306_set_pixel(ssd, x + col, y + row, pixel);
-        }
-    }
+#define BIG_CHAR_WIDTH 16
+#define BIG_CHAR_PAGES 4 // 32 linhas
+
+// Desenha um caractere grande no buffer ssd[] a partir do glifo em colunas (font_big_columns.h):
+// bytes inteiros copiados por página, com deslocamento quando y não é múltiplo de 8
+// (ssd1306_blit_columns marca as colunas alteradas para o envio parcial)
+// Somente as BIG_FONT_INK_PAGES primeiras páginas têm pixels: as vazias não são tocadas.
+void draw_big_char(uint8_t *ssd, int x, int y, const uint8_t *columns) {
+    ssd1306_blit_columns(ssd, x, y, columns, BIG_CHAR_WIDTH, BIG_FONT_INK_PAGES);
 }
 #endif
\ No newline at end of file
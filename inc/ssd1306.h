@@ -2,15 +2,34 @@
 extern void calculate_render_area_buffer_length(struct render_area *area);
 extern void ssd1306_send_command(uint8_t cmd);
 extern void ssd1306_send_command_list(uint8_t *ssd, int number);
+extern void ssd1306_command_batch(i2c_inst_t *i2c, uint8_t address, const uint8_t *commands, int number);
+extern void ssd1306_send_command_batch(const uint8_t *commands, int number);
 extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
 extern void ssd1306_init();
+extern void ssd1306_init_async();
 extern void ssd1306_scroll(bool set);
 extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern void ssd1306_dma_init();
+extern void render_on_display_async(uint8_t *ssd, struct render_area *area);
+extern void render_dirty_on_display(uint8_t *ssd);
+extern void render_dirty_on_display_async(uint8_t *ssd);
+extern void ssd1306_clear_dirty();
+extern void ssd1306_double_buffer_init(uint8_t *front, uint8_t *back);
+extern uint8_t *ssd1306_back_buffer();
+extern void ssd1306_swap_buffers();
+extern void ssd1306_clear_area(uint8_t *ssd, struct render_area *area);
+extern bool ssd1306_flush_busy();
+extern void ssd1306_flush_wait();
+extern volatile uint32_t ssd1306_flush_aborts;
+extern void (*volatile ssd1306_flush_done_cb)(void);
 extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
+extern void ssd1306_blit_columns(uint8_t *ssd, int x, int y, const uint8_t *columns, int width, int pages);
 extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
 extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
 //extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
 extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, const char *string);
+extern void ssd1306_draw_string_cached(uint8_t *ssd, int16_t x, int16_t y, const char *string);
+extern uint32_t ssd1306_text_cache_misses;
 extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 extern void ssd1306_config(ssd1306_t *ssd);
 extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
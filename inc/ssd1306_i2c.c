@@ -1,10 +1,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
 
@@ -13,39 +15,184 @@ void calculate_render_area_buffer_length(struct render_area *area) {
     area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
 }
 
+// Transação de endereçamento de um trecho: controle 0x00 + 6 bytes de comando
+#define flush_span_command_words 7
+
+// Envio assíncrono: palavras de DATA_CMD (byte + bit de STOP) lidas pelo DMA.
+// Cada conjunto comporta o pior caso de um trecho por página (comandos + byte de controle + dados);
+// são dois para que o quadro pendente seja montado enquanto o DMA lê o anterior.
+#define flush_words_length (ssd1306_buffer_length + ssd1306_n_pages * (flush_span_command_words + 1))
+static uint16_t flush_words[2][flush_words_length];
+static volatile uint8_t flush_words_dma = 0; // Conjunto entregue por último ao DMA
+static int flush_dma_chan = -1;
+static volatile bool flush_dma_active = false;
+volatile uint32_t ssd1306_flush_aborts = 0;
+void (*volatile ssd1306_flush_done_cb)(void) = NULL;
+
+// Regiões alteradas: um trecho de colunas por página
+typedef struct {
+    uint8_t pages; // bit p → página p possui trecho pendente
+    uint8_t first[ssd1306_n_pages];
+    uint8_t last[ssd1306_n_pages];
+} damage_t;
+
+static damage_t dirty = {0}; // Alterações desde o último envio
+
+// Duplo buffer: o desenho vai para o de trás; o da frente guarda o quadro apresentado
+static uint8_t *front_buffer = NULL;
+static uint8_t *back_buffer = NULL;
+static uint16_t *swap_words;              // Palavras já montadas do quadro apresentado
+static int swap_words_n;
+static volatile bool swap_pending = false; // Quadro apresentado aguardando o DMA ficar livre
+
+static void flush_start(uint16_t *words, int n);
+
+// Conjunto de palavras livre para montar o próximo envio
+static inline uint16_t *flush_words_free(void) {
+    return flush_words[flush_words_dma ^ 1];
+}
+
+// Fim da transferência do DMA: todas as palavras já estão no FIFO de TX
+static void ssd1306_flush_dma_handler(void) {
+    dma_channel_acknowledge_irq1(flush_dma_chan);
+    flush_dma_active = false;
+
+    // O DMA terminou de ler as palavras: o quadro apresentado, já montado, entra logo em
+    // seguida, sem esperar o FIFO esvaziar (as transações seguem em sequência no barramento)
+    if (swap_pending) {
+        swap_pending = false;
+        flush_start(swap_words, swap_words_n);
+    }
+
+    if (ssd1306_flush_done_cb) {
+        ssd1306_flush_done_cb();
+    }
+}
+
+// Reserva o canal DMA do envio assíncrono e registra a interrupção de conclusão
+void ssd1306_dma_init() {
+    flush_dma_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(flush_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16); // DATA_CMD não aceita escrita de 8 bits
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_I2C1_TX);
+    dma_channel_configure(flush_dma_chan, &c, &i2c_get_hw(i2c1)->data_cmd, flush_words[0], 0, false);
+
+    dma_channel_set_irq1_enabled(flush_dma_chan, true);
+    irq_set_exclusive_handler(DMA_IRQ_1, ssd1306_flush_dma_handler);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+// Indica se ainda há um envio assíncrono em curso (DMA ou bytes no FIFO/barramento)
+bool ssd1306_flush_busy() {
+    if (flush_dma_chan < 0) {
+        return false;
+    }
+
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // NACK ou perda de arbitragem: o FIFO foi descartado, o quadro é perdido
+        dma_channel_abort(flush_dma_chan);
+        (void)hw->clr_tx_abrt;
+        flush_dma_active = false;
+        swap_pending = false;
+        ssd1306_flush_aborts++;
+        return false;
+    }
+
+    return flush_dma_active || swap_pending || !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Aguarda o fim do envio assíncrono em curso
+void ssd1306_flush_wait() {
+    while (ssd1306_flush_busy()) {
+        tight_loop_contents();
+    }
+}
+
 // Processo de escrita do i2c espera um byte de controle, seguido por dados
 void ssd1306_send_command(uint8_t command) {
     uint8_t buffer[2] = {0x80, command};
+    ssd1306_flush_wait(); // Não intercala com um envio assíncrono
     i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
 }
 
-// Envia uma lista de comandos ao hardware
+// Envia uma lista de comandos numa única transação: o byte de controle 0x00 (Co = 0, D/C = 0)
+// indica que todos os bytes seguintes são comandos. Listas longas são divididas em blocos.
+void ssd1306_command_batch(i2c_inst_t *i2c, uint8_t address, const uint8_t *commands, int number) {
+    uint8_t buffer[ssd1306_max_command_batch + 1];
+
+    ssd1306_flush_wait(); // Não intercala com um envio assíncrono
+    buffer[0] = 0x00;
+    while (number > 0) {
+        int n = number < ssd1306_max_command_batch ? number : ssd1306_max_command_batch;
+        memcpy(buffer + 1, commands, n);
+        i2c_write_blocking(i2c, address, buffer, n + 1, false);
+        commands += n;
+        number -= n;
+    }
+}
+
+// Envia uma lista de comandos ao display principal numa única transação
+void ssd1306_send_command_batch(const uint8_t *commands, int number) {
+    ssd1306_command_batch(i2c1, ssd1306_i2c_address, commands, number);
+}
+
+// Envia uma lista de comandos ao hardware, um comando por transação
 void ssd1306_send_command_list(uint8_t *ssd, int number) {
     for (int i = 0; i < number; i++) {
         ssd1306_send_command(ssd[i]);
     }
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
+// Envia sem cópia um trecho de um framebuffer registrado: o byte de controle é escrito em ssd[-1]
+// (o framebuffer reserva esse byte à frente de ssd[]; num trecho interno, o byte anterior é preservado)
+static void ssd1306_send_buffer_in_place(uint8_t ssd[], int buffer_length) {
+    uint8_t saved = ssd[-1];
 
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
+    ssd1306_flush_wait();
+    ssd[-1] = 0x40;
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, ssd - 1, buffer_length + 1, false);
+    ssd[-1] = saved;
+}
 
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
+// Indica se 'ssd' aponta para dentro de um dos framebuffers de ssd1306_double_buffer_init()
+static bool ssd1306_in_framebuffer(const uint8_t *ssd) {
+    const uint8_t *buffers[2] = {front_buffer, back_buffer};
 
-    free(temp_buffer);
+    for (int i = 0; i < 2; i++) {
+        if (buffers[i] && ssd >= buffers[i] && ssd < buffers[i] + ssd1306_buffer_length) {
+            return true;
+        }
+    }
+    return false;
 }
 
-// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init() {
-    uint8_t commands[] = {
-        ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
-        ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
-        ssd1306_set_mux_ratio, ssd1306_height - 1,
-        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
-        0x00, ssd1306_set_common_pin_configuration,
+// Envia os dados de qualquer buffer: os framebuffers registrados seguem sem cópia,
+// os demais são copiados atrás do byte de controle
+void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
+    static uint8_t copy[ssd1306_buffer_length + 1] = {0x40};
+
+    if (ssd1306_in_framebuffer(ssd)) {
+        ssd1306_send_buffer_in_place(ssd, buffer_length);
+        return;
+    }
+
+    assert(buffer_length <= ssd1306_buffer_length);
+    ssd1306_flush_wait();
+    memcpy(copy + 1, ssd, buffer_length);
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, copy, buffer_length + 1, false);
+}
+
+// Lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
+static const uint8_t init_commands[] = {
+    ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
+    ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
+    ssd1306_set_mux_ratio, ssd1306_height - 1,
+    ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
+    0x00, ssd1306_set_common_pin_configuration,
     
 #if ((ssd1306_width == 128) && (ssd1306_height == 32))
     0x02,
@@ -54,14 +201,34 @@ void ssd1306_init() {
 #else
     0x02,
 #endif
-        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
-        0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
-        0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
-        ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
-        ssd1306_set_display | 0x01,
-    };
+    ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
+    0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
+    0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
+    ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
+    ssd1306_set_display | 0x01,
+};
+
+void ssd1306_init() {
+    ssd1306_send_command_batch(init_commands, count_of(init_commands));
+}
 
-    ssd1306_send_command_list(commands, count_of(commands));
+// Enfileira a inicialização no DMA do envio assíncrono e retorna; quadros posteriores seguem
+// atrás dela no barramento (exige ssd1306_dma_init(), senão inicializa de forma bloqueante)
+void ssd1306_init_async() {
+    if (flush_dma_chan < 0) {
+        ssd1306_init();
+        return;
+    }
+
+    int n = 0;
+    ssd1306_flush_wait();
+    uint16_t *words = flush_words_free();
+    words[n++] = 0x00; // Co = 0, D/C = 0: todos os bytes seguintes são comandos
+    for (uint i = 0; i < count_of(init_commands); i++) {
+        words[n++] = init_commands[i];
+    }
+    words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    flush_start(words, n);
 }
 
 // Cria a lista de comandos para configurar o scrolling
@@ -71,7 +238,7 @@ void ssd1306_scroll(bool set) {
         0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
     };
 
-    ssd1306_send_command_list(commands, count_of(commands));
+    ssd1306_send_command_batch(commands, count_of(commands));
 }
 
 // Atualiza uma parte do display com uma área de renderização
@@ -81,10 +248,217 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
         ssd1306_set_page_address, area->start_page, area->end_page
     };
 
-    ssd1306_send_command_list(commands, count_of(commands));
+    ssd1306_send_command_batch(commands, count_of(commands));
     ssd1306_send_buffer(ssd, area->buffer_length);
 }
 
+// Acrescenta às palavras do DMA uma transação de endereçamento e uma de dados (cada uma termina em STOP)
+static int flush_queue_area(uint16_t *words, int n, const uint8_t *data, const struct render_area *area) {
+    const uint8_t commands[] = {
+        0x00, // Co = 0, D/C = 0: todos os bytes seguintes são comandos
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+
+    for (uint i = 0; i < count_of(commands); i++) {
+        words[n++] = commands[i];
+    }
+    words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    // A cópia libera 'ssd' para o próximo quadro enquanto o painel é atualizado
+    words[n++] = 0x40;
+    for (int i = 0; i < area->buffer_length; i++) {
+        words[n++] = data[i];
+    }
+    words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    return n;
+}
+
+// Dispara o DMA sobre as 'n' primeiras palavras de 'words'
+static void flush_start(uint16_t *words, int n) {
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+    if (hw->tar != ssd1306_i2c_address) {
+        // Trocar o alvo exige desabilitar o bloco: só acontece com o FIFO vazio
+        hw->enable = 0;
+        hw->tar = ssd1306_i2c_address;
+        hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+    }
+
+    flush_dma_active = true;
+    flush_words_dma = words == flush_words[1];
+    dma_channel_transfer_from_buffer_now(flush_dma_chan, words, n);
+}
+
+// Versão não bloqueante: copia a área para as palavras do DMA e retorna logo após iniciar o envio
+void render_on_display_async(uint8_t *ssd, struct render_area *area) {
+    if (flush_dma_chan < 0) {
+        render_on_display(ssd, area); // DMA não inicializado
+        return;
+    }
+
+    ssd1306_flush_wait(); // Aguarda o envio anterior
+    uint16_t *words = flush_words_free();
+    flush_start(words, flush_queue_area(words, 0, ssd, area));
+}
+
+// Marca as colunas [x_0, x_1] da página como alteradas
+static inline void ssd1306_mark_dirty(int page, int x_0, int x_1) {
+    if (!(dirty.pages & (1u << page))) {
+        dirty.pages |= 1u << page;
+        dirty.first[page] = x_0;
+        dirty.last[page] = x_1;
+        return;
+    }
+    if (x_0 < dirty.first[page]) {
+        dirty.first[page] = x_0;
+    }
+    if (x_1 > dirty.last[page]) {
+        dirty.last[page] = x_1;
+    }
+}
+
+// Descarta as regiões pendentes (o painel já mostra o framebuffer inteiro)
+void ssd1306_clear_dirty() {
+    dirty.pages = 0;
+}
+
+// Marca a tela inteira para o próximo envio
+static void ssd1306_mark_all_dirty() {
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        ssd1306_mark_dirty(page, 0, ssd1306_width - 1);
+    }
+}
+
+// Área de renderização do trecho alterado de uma página
+static struct render_area damage_area(const damage_t *damage, int page) {
+    struct render_area span = {
+        .start_column = damage->first[page],
+        .end_column = damage->last[page],
+        .start_page = page,
+        .end_page = page
+    };
+    calculate_render_area_buffer_length(&span);
+    return span;
+}
+
+static struct render_area dirty_area(int page) {
+    return damage_area(&dirty, page);
+}
+
+// Enfileira todos os trechos de 'damage' do framebuffer de tela cheia 'ssd'
+static int flush_queue_damage(uint16_t *words, const uint8_t *ssd, const damage_t *damage) {
+    int n = 0;
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        if (damage->pages & (1u << page)) {
+            struct render_area span = damage_area(damage, page);
+            n = flush_queue_area(words, n, ssd + page * ssd1306_width + span.start_column, &span);
+        }
+    }
+    return n;
+}
+
+// Envia apenas os trechos alterados do framebuffer de tela cheia 'ssd'
+void render_dirty_on_display(uint8_t *ssd) {
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        if (dirty.pages & (1u << page)) {
+            struct render_area span = dirty_area(page);
+            render_on_display(ssd + page * ssd1306_width + span.start_column, &span);
+        }
+    }
+    dirty.pages = 0;
+}
+
+// Versão não bloqueante: todos os trechos alterados seguem numa única transferência do DMA
+void render_dirty_on_display_async(uint8_t *ssd) {
+    if (flush_dma_chan < 0) {
+        render_dirty_on_display(ssd);
+        return;
+    }
+    if (dirty.pages == 0) {
+        return;
+    }
+
+    ssd1306_flush_wait();
+    uint16_t *words = flush_words_free();
+    int n = flush_queue_damage(words, ssd, &dirty);
+    dirty.pages = 0;
+    flush_start(words, n);
+}
+
+// Registra o par de framebuffers de tela cheia (cada um com ssd[-1] gravável: o envio bloqueante
+// escreve ali o byte de controle, sem copiar o quadro)
+void ssd1306_double_buffer_init(uint8_t *front, uint8_t *back) {
+    memcpy(back, front, ssd1306_buffer_length);
+    front_buffer = front;
+    back_buffer = back;
+}
+
+// Framebuffer onde o próximo quadro deve ser desenhado
+uint8_t *ssd1306_back_buffer() {
+    return back_buffer;
+}
+
+// Apresenta o buffer de trás: ele passa a ser o da frente e seus trechos alterados seguem
+// por DMA. As palavras são montadas aqui, no conjunto que o DMA não está lendo; se um envio
+// ainda estiver em curso, o quadro fica pendente e a interrupção do DMA apenas o dispara.
+// O painel recebe sempre quadros completos.
+void ssd1306_swap_buffers() {
+    if (dirty.pages == 0) {
+        return; // Quadro idêntico ao apresentado
+    }
+    if (flush_dma_chan < 0) {
+        render_dirty_on_display(back_buffer);
+        memcpy(front_buffer, back_buffer, ssd1306_buffer_length);
+        return;
+    }
+
+    while (swap_pending) {
+        tight_loop_contents(); // Dois quadros apresentados durante um mesmo envio
+    }
+
+    uint8_t *drawn = back_buffer;
+    back_buffer = front_buffer;
+    front_buffer = drawn;
+
+    // O novo buffer de trás recebe as alterações, voltando a espelhar o quadro apresentado
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        if (dirty.pages & (1u << page)) {
+            int offset = page * ssd1306_width + dirty.first[page];
+            memcpy(back_buffer + offset, front_buffer + offset, dirty.last[page] - dirty.first[page] + 1);
+        }
+    }
+
+    // Sem envio pendente, só o conjunto de 'flush_words_dma' pode estar em uso pelo DMA
+    uint16_t *words = flush_words_free();
+    int n = flush_queue_damage(words, front_buffer, &dirty);
+    dirty.pages = 0;
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (flush_dma_active) {
+        swap_words = words;
+        swap_words_n = n;
+        swap_pending = true;
+        restore_interrupts(irq);
+        return;
+    }
+    restore_interrupts(irq);
+
+    flush_start(words, n);
+}
+
+// Zera uma área do framebuffer de tela cheia sem enviá-la, marcando apenas os bytes alterados
+void ssd1306_clear_area(uint8_t *ssd, struct render_area *area) {
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        uint8_t *row = ssd + page * ssd1306_width;
+        for (int x = area->start_column; x <= area->end_column; x++) {
+            if (row[x]) {
+                row[x] = 0;
+                ssd1306_mark_dirty(page, x, x);
+            }
+        }
+    }
+}
+
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
 void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
@@ -101,7 +475,50 @@ void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
         byte &= ~(1 << (y % 8));
     }
 
-    ssd[byte_idx] = byte;
+    if (byte != ssd[byte_idx]) {
+        ssd[byte_idx] = byte;
+        ssd1306_mark_dirty(y / 8, x, x);
+    }
+}
+
+// Combina os bits de 'mask' num byte do framebuffer, marcando a coluna se o byte mudar
+static inline void ssd1306_merge_byte(uint8_t *ssd, int page, int x, uint8_t bits, uint8_t mask) {
+    uint8_t *target = &ssd[page * ssd1306_width + x];
+    uint8_t value = (*target & ~mask) | (bits & mask);
+
+    if (value != *target) {
+        *target = value;
+        ssd1306_mark_dirty(page, x, x);
+    }
+}
+
+// Copia (opaco) um bloco de 'pages' x 'width' bytes em formato de página para (x, y).
+// Com y fora do múltiplo de 8, cada byte é dividido entre duas páginas por deslocamento.
+void ssd1306_blit_columns(uint8_t *ssd, int x, int y, const uint8_t *columns, int width, int pages) {
+    assert(y >= 0);
+
+    int first_page = y / 8;
+    int shift = y % 8;
+
+    for (int col = 0; col < width; col++) {
+        int fx = x + col;
+        if (fx < 0 || fx >= ssd1306_width) {
+            continue;
+        }
+
+        for (int p = 0; p < pages; p++) {
+            int page = first_page + p;
+            if (page >= ssd1306_n_pages) {
+                break;
+            }
+
+            uint8_t bits = columns[p * width + col];
+            ssd1306_merge_byte(ssd, page, fx, bits << shift, 0xFF << shift);
+            if (shift && page + 1 < ssd1306_n_pages) {
+                ssd1306_merge_byte(ssd, page + 1, fx, bits >> (8 - shift), 0xFF >> (8 - shift));
+            }
+        }
+    }
 }
 
 // Algoritmo de Bresenham básico
@@ -133,16 +550,23 @@ void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool se
 }
 
 // Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
+// Índice do glifo de cada caractere ASCII em font[] (0 = vazio); minúsculas usam o glifo da maiúscula
+#define FONT_LETTER(c) [c] = (c) - 'A' + 1, [(c) + ('a' - 'A')] = (c) - 'A' + 1
+#define FONT_DIGIT(c) [c] = (c) - '0' + 27
+
+static const uint8_t font_index[128] = {
+    FONT_LETTER('A'), FONT_LETTER('B'), FONT_LETTER('C'), FONT_LETTER('D'), FONT_LETTER('E'), FONT_LETTER('F'),
+    FONT_LETTER('G'), FONT_LETTER('H'), FONT_LETTER('I'), FONT_LETTER('J'), FONT_LETTER('K'), FONT_LETTER('L'),
+    FONT_LETTER('M'), FONT_LETTER('N'), FONT_LETTER('O'), FONT_LETTER('P'), FONT_LETTER('Q'), FONT_LETTER('R'),
+    FONT_LETTER('S'), FONT_LETTER('T'), FONT_LETTER('U'), FONT_LETTER('V'), FONT_LETTER('W'), FONT_LETTER('X'),
+    FONT_LETTER('Y'), FONT_LETTER('Z'),
+    FONT_DIGIT('0'), FONT_DIGIT('1'), FONT_DIGIT('2'), FONT_DIGIT('3'), FONT_DIGIT('4'),
+    FONT_DIGIT('5'), FONT_DIGIT('6'), FONT_DIGIT('7'), FONT_DIGIT('8'), FONT_DIGIT('9'),
+};
+
+static inline int ssd1306_get_font(uint8_t character)
 {
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  }
-  else
-    return 0;
+  return character < count_of(font_index) ? font_index[character] : 0;
 }
 
 // Desenha um único caractere no display
@@ -153,12 +577,15 @@ void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
 
     y = y / 8;
 
-    character = toupper(character);
     int idx = ssd1306_get_font(character);
     int fb_idx = y * 128 + x;
 
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
+    for (int i = 0; i < 8; i++, fb_idx++) {
+        uint8_t column = font[idx * 8 + i];
+        if (ssd[fb_idx] != column) {
+            ssd[fb_idx] = column;
+            ssd1306_mark_dirty(y, x + i, x + i);
+        }
     }
 }
 
@@ -174,6 +601,60 @@ void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
     }
 }
 
+// Cache de strings já rasterizadas (colunas prontas de uma página), para textos que se repetem
+typedef struct {
+    char text[ssd1306_text_cache_max_chars + 1];
+    uint8_t length;
+    uint8_t columns[ssd1306_text_cache_max_chars * 8];
+} text_cache_entry_t;
+
+static text_cache_entry_t text_cache[ssd1306_text_cache_entries];
+static uint text_cache_next = 0; // Substituição circular
+uint32_t ssd1306_text_cache_misses = 0;
+
+// Devolve a entrada do cache da string, rasterizando-a apenas na primeira vez
+static const text_cache_entry_t *text_cache_lookup(const char *string) {
+    for (uint i = 0; i < count_of(text_cache); i++) {
+        if (text_cache[i].length && strcmp(text_cache[i].text, string) == 0) {
+            return &text_cache[i];
+        }
+    }
+
+    text_cache_entry_t *entry = &text_cache[text_cache_next];
+    text_cache_next = (text_cache_next + 1) % count_of(text_cache);
+    ssd1306_text_cache_misses++;
+
+    uint length = 0;
+    while (string[length] && length < ssd1306_text_cache_max_chars) {
+        const uint8_t *glyph = &font[ssd1306_get_font(string[length]) * 8];
+        memcpy(&entry->columns[length * 8], glyph, 8);
+        entry->text[length] = string[length];
+        length++;
+    }
+    entry->text[length] = '\0';
+    entry->length = length;
+    return entry;
+}
+
+// Desenha uma string a partir do cache: textos inalterados não são rasterizados de novo e,
+// com a marcação de regiões alteradas, não geram tráfego no I2C
+void ssd1306_draw_string_cached(uint8_t *ssd, int16_t x, int16_t y, const char *string) {
+    if (x > ssd1306_width - 8 || y > ssd1306_height - 8 || !*string) {
+        return;
+    }
+    if (strlen(string) > ssd1306_text_cache_max_chars) {
+        ssd1306_draw_string(ssd, x, y, (char *)string); // Não cabe numa entrada
+        return;
+    }
+
+    const text_cache_entry_t *entry = text_cache_lookup(string);
+    int chars = entry->length;
+    if (chars > (ssd1306_width - x) / 8) {
+        chars = (ssd1306_width - x) / 8; // Mesmo corte de ssd1306_draw_char()
+    }
+    ssd1306_blit_columns(ssd, x, (y / 8) * 8, entry->columns, chars * 8, 1);
+}
+
 // Comando de configuração com base na estrutura ssd1306_t
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
@@ -183,31 +664,19 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
 
 // Função de configuração do display para o caso do bitmap
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
+    const uint8_t commands[] = {
+        ssd1306_set_display | 0x00, ssd1306_set_memory_mode, 0x01,
+        ssd1306_set_display_start_line | 0x00, ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio, ssd1306_height - 1,
+        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset, 0x00,
+        ssd1306_set_common_pin_configuration, 0x12,
+        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge, 0xF1,
+        ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast, 0xFF,
+        ssd1306_set_entire_on, ssd1306_set_normal_display,
+        ssd1306_set_charge_pump, 0x14, ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_command_batch(ssd->i2c_port, ssd->address, commands, count_of(commands));
 }
 
 // Inicializa o display para o caso de exibição de bitmap
@@ -225,12 +694,12 @@ void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool externa
 
 // Envia os dados ao display
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
+    const uint8_t commands[] = {
+        ssd1306_set_column_address, 0, ssd->width - 1,
+        ssd1306_set_page_address, 0, ssd->pages - 1
+    };
+
+    ssd1306_command_batch(ssd->i2c_port, ssd->address, commands, count_of(commands));
     i2c_write_blocking(
     ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
 }
@@ -244,14 +713,8 @@ void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
     }
 }
 
+// Limpa apenas o framebuffer; a tela inteira segue no próximo envio dos trechos alterados
 void ssd1306_clear_display(uint8_t *ssd) {
     memset(ssd, 0, ssd1306_buffer_length);
-    struct render_area area = {
-        .start_column = 0,
-        .end_column = ssd1306_width - 1,
-        .start_page = 0,
-        .end_page = ssd1306_n_pages - 1
-    };
-    calculate_render_area_buffer_length(&area);
-    render_on_display(ssd, &area);
+    ssd1306_mark_all_dirty();
 }
@@ -43,6 +43,12 @@
 #define ssd1306_page_height _u(8)
 #define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
 #define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
+#define ssd1306_frame_length (ssd1306_buffer_length + 1) // Byte de controle 0x40 + framebuffer
+
+#define ssd1306_max_command_batch 32 // Comandos por transação em ssd1306_command_batch()
+
+#define ssd1306_text_cache_entries 6     // Strings pré-rasterizadas mantidas em cache
+#define ssd1306_text_cache_max_chars 16  // Uma linha inteira da tela (128 / 8)
 
 #define ssd1306_write_mode _u(0xFE)
 #define ssd1306_read_mode _u(0xFF)
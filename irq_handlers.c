@@ -13,6 +13,15 @@
  *      sinalizar a finalização da transferência de dados
  *      via flag global 'dma_temp_done'.
  *
+ *      No modo ping-pong (TAREFA1_PING_PONG=1) o mesmo handler
+ *      atende os dois canais encadeados: rearma o endereço de
+ *      escrita do canal que terminou e marca a metade pronta
+ *      em 'dma_temp_metades_prontas'.
+ *
+ *      No modo streaming (TAREFA1_STREAMING=1) o canal se
+ *      redispara sozinho sobre um anel; o handler apenas
+ *      alterna a metade concluída.
+ *
  *  Relacionamento:
  *      - Este handler é registrado em 'setup.c' usando:
  *            irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
@@ -24,12 +33,52 @@
  * ------------------------------------------------------------
  */
 
+#include <stddef.h>
 #include "hardware/dma.h"
 #include "irq_handlers.h"
+#include "setup.h"
 
 // Flag global que sinaliza a conclusão da transferência DMA
 volatile bool dma_temp_done = false;
 
+// Permite que o executor seja acordado pelo DMA (ex.: liberar a coleta da Tarefa 1)
+void (*volatile dma_temp_notificar)(void) = NULL;
+
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+// Metades do buffer de aquisição (definidas pela Tarefa 1)
+uint16_t *dma_temp_metades[2];
+volatile uint32_t dma_temp_metades_prontas = 0;
+volatile uint32_t dma_temp_metades_perdidas = 0;
+volatile uint8_t dma_temp_metade_seguinte = 0;
+volatile uint8_t dma_temp_metade_recente = 1;
+
+/**
+ * @brief Marca uma metade como pronta, contando as que não foram consumidas.
+ */
+static void marcar_metade_pronta(uint metade)
+{
+    if (dma_temp_metades_prontas & (1u << metade))
+        dma_temp_metades_perdidas++; // Consumidor não acompanhou
+    dma_temp_metades_prontas |= 1u << metade;
+    dma_temp_metade_recente = metade;
+}
+#endif
+
+#if TAREFA1_PING_PONG
+/**
+ * @brief Trata o fim de uma metade: rearma o canal e marca a metade pronta.
+ *
+ * O canal será disparado novamente pelo parceiro (chain_to); basta
+ * restaurar o endereço de escrita. O contador de transferências é
+ * recarregado automaticamente a cada disparo.
+ */
+static void pingpong_metade_concluida(uint chan, uint metade)
+{
+    dma_channel_set_write_addr(chan, dma_temp_metades[metade], false);
+    marcar_metade_pronta(metade);
+}
+#endif
+
 /**
  * @brief Handler de interrupção do canal DMA 0.
  *
@@ -41,6 +90,25 @@ volatile bool dma_temp_done = false;
  */
 void dma_handler_temp()
 {
+#if TAREFA1_PING_PONG
+    uint32_t ints = dma_hw->ints0 & ((1u << DMA_TEMP_CHANNEL) | (1u << DMA_TEMP_CHANNEL_B));
+    dma_hw->ints0 = ints; // Limpa as interrupções atendidas
+
+    if (ints & (1u << DMA_TEMP_CHANNEL))
+        pingpong_metade_concluida(DMA_TEMP_CHANNEL, 0);
+    if (ints & (1u << DMA_TEMP_CHANNEL_B))
+        pingpong_metade_concluida(DMA_TEMP_CHANNEL_B, 1);
+#elif TAREFA1_STREAMING
+    dma_hw->ints0 = 1u << DMA_TEMP_CHANNEL; // Limpa a interrupção do canal de dados
+
+    // As metades do anel se alternam a cada disparo
+    marcar_metade_pronta(dma_temp_metade_seguinte);
+    dma_temp_metade_seguinte ^= 1;
+#else
     dma_hw->ints0 = 1u << 0; // Limpa a interrupção do canal 0
     dma_temp_done = true;    // Sinaliza conclusão para o executor
+#endif
+
+    if (dma_temp_notificar)
+        dma_temp_notificar();
 }
\ No newline at end of file
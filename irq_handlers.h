@@ -2,8 +2,20 @@
 #define IRQ_HANDLERS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 extern volatile bool dma_temp_done;
+
+// Notificação opcional chamada ao fim de cada interrupção do DMA (contexto de IRQ)
+extern void (*volatile dma_temp_notificar)(void);
+
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+extern uint16_t *dma_temp_metades[2];
+extern volatile uint32_t dma_temp_metades_prontas; // bit 0 → metade 0, bit 1 → metade 1
+extern volatile uint32_t dma_temp_metades_perdidas; // Metades sobrescritas antes de consumidas
+extern volatile uint8_t dma_temp_metade_seguinte;   // Streaming: metade que o anel preenche agora
+extern volatile uint8_t dma_temp_metade_recente;    // Última metade marcada pronta
+#endif
 void dma_handler_temp(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: profiler.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Estatísticas de tempo de execução por tarefa: extremos,
+ *      média, anel de amostras recentes e histograma em
+ *      potências de 2.
+ *
+ *      O registro custa algumas operações inteiras (sem
+ *      ordenação nem ponto flutuante); percentis e relatório
+ *      só são calculados quando pedidos.
+ *
+ *  Relacionamento:
+ *      - Alimentado por 'scheduler_dispatch()' e pelo executivo
+ *        cíclico; o relatório é impresso por 'tarefas.c'.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "profiler.h"
+#include "hardware/sync.h"
+
+static profiler_stats_t stats[PROFILER_MAX_TASKS];
+static uint stats_count;
+
+// Marcos de inicialização, na ordem em que ocorreram
+static struct
+{
+    const char *nome;
+    uint32_t us;
+} marcos[PROFILER_MAX_MARCOS];
+static uint marcos_count;
+
+/**
+ * @brief Balde do histograma: posição do bit mais significativo (0 e 1 us → balde 0).
+ */
+static uint profiler_balde(uint32_t duracao_us)
+{
+    uint balde = 31 - __builtin_clz(duracao_us | 1);
+    return balde < PROFILER_BALDES ? balde : PROFILER_BALDES - 1;
+}
+
+void profiler_init(uint count)
+{
+    assert(count <= PROFILER_MAX_TASKS);
+
+    memset(stats, 0, sizeof(stats));
+    for (uint i = 0; i < count; i++)
+        stats[i].min_us = UINT32_MAX;
+    stats_count = count;
+}
+
+void profiler_nomear(uint tarefa, const char *nome)
+{
+    if (tarefa < stats_count)
+        stats[tarefa].nome = nome;
+}
+
+void profiler_registrar(uint tarefa, uint32_t duracao_us)
+{
+    if (tarefa >= stats_count)
+        return;
+
+    profiler_stats_t *s = &stats[tarefa];
+    s->n++;
+    s->soma_us += duracao_us;
+    if (duracao_us < s->min_us)
+        s->min_us = duracao_us;
+    if (duracao_us > s->max_us)
+        s->max_us = duracao_us;
+    s->hist[profiler_balde(duracao_us)]++;
+    s->anel[s->cabeca] = duracao_us;
+    s->cabeca = (s->cabeca + 1) % PROFILER_AMOSTRAS;
+}
+
+void profiler_marcar(const char *nome)
+{
+    uint32_t agora = profiler_agora();
+
+    uint32_t irq = save_and_disable_interrupts();
+    bool novo = marcos_count < PROFILER_MAX_MARCOS;
+    for (uint i = 0; i < marcos_count && novo; i++)
+        novo = marcos[i].nome != nome;
+    if (novo)
+    {
+        marcos[marcos_count].nome = nome;
+        marcos[marcos_count].us = agora;
+        marcos_count++;
+    }
+    restore_interrupts(irq);
+}
+
+const profiler_stats_t *profiler_stats(uint tarefa)
+{
+    return tarefa < stats_count ? &stats[tarefa] : NULL;
+}
+
+uint32_t profiler_percentil_us(uint tarefa, uint pct)
+{
+    if (tarefa >= stats_count || stats[tarefa].n == 0)
+        return 0;
+
+    const profiler_stats_t *s = &stats[tarefa];
+    uint n = s->n < PROFILER_AMOSTRAS ? s->n : PROFILER_AMOSTRAS;
+    uint32_t ordenadas[PROFILER_AMOSTRAS];
+
+    // Ordenação por inserção: no máximo PROFILER_AMOSTRAS valores, só no relatório
+    for (uint i = 0; i < n; i++)
+    {
+        uint32_t v = s->anel[i];
+        uint j = i;
+        for (; j > 0 && ordenadas[j - 1] > v; j--)
+            ordenadas[j] = ordenadas[j - 1];
+        ordenadas[j] = v;
+    }
+
+    uint posicao = (n * pct + 99) / 100; // ceil(n * pct / 100)
+    return ordenadas[posicao > 0 ? posicao - 1 : 0];
+}
+
+uint32_t profiler_percentil_hist_us(uint tarefa, uint pct)
+{
+    if (tarefa >= stats_count || stats[tarefa].n == 0)
+        return 0;
+
+    const profiler_stats_t *s = &stats[tarefa];
+    uint64_t alvo = ((uint64_t)s->n * pct + 99) / 100;
+    uint64_t acumulado = 0;
+
+    for (uint b = 0; b < PROFILER_BALDES; b++)
+    {
+        acumulado += s->hist[b];
+        if (acumulado >= alvo)
+        {
+            // Limite superior do balde, sem passar do máximo observado (o último balde é aberto)
+            if (b == PROFILER_BALDES - 1)
+                return s->max_us;
+            uint32_t limite = (1u << (b + 1)) - 1;
+            return limite < s->max_us ? limite : s->max_us;
+        }
+    }
+    return s->max_us;
+}
+
+void profiler_relatorio(bool histogramas)
+{
+    if (marcos_count)
+    {
+        printf("Inicialização (us desde o reset):");
+        for (uint i = 0; i < marcos_count; i++)
+            printf(" %s %lu%s", marcos[i].nome, (unsigned long)marcos[i].us, i + 1 < marcos_count ? " |" : "\n");
+    }
+
+    printf("%-14s %8s %9s %9s %9s %9s %9s\n", "tarefa", "n", "min us", "media us", "p99 us", "p99h us", "max us");
+    for (uint i = 0; i < stats_count; i++)
+    {
+        const profiler_stats_t *s = &stats[i];
+        if (s->n == 0)
+            continue;
+
+        printf("%-14s %8lu %9lu %9lu %9lu %9lu %9lu\n",
+               s->nome ? s->nome : "?",
+               (unsigned long)s->n,
+               (unsigned long)s->min_us,
+               (unsigned long)(s->soma_us / s->n),
+               (unsigned long)profiler_percentil_us(i, 99),
+               (unsigned long)profiler_percentil_hist_us(i, 99),
+               (unsigned long)s->max_us);
+
+        if (!histogramas)
+            continue;
+        for (uint b = 0; b < PROFILER_BALDES; b++)
+        {
+            if (s->hist[b])
+                printf("    [%lu, %lu) us: %lu\n",
+                       b ? (unsigned long)(1u << b) : 0ul,
+                       (unsigned long)(1u << (b + 1)),
+                       (unsigned long)s->hist[b]);
+        }
+    }
+}
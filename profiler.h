@@ -0,0 +1,125 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: profiler.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Perfil de tempo de execução por tarefa.
+ *
+ *      O despacho (escalonador ou executivo cíclico) mede cada
+ *      execução com o timer de 64 bits do RP2040 (resolução de
+ *      1 us; o SysTick de 24 bits estouraria durante a janela
+ *      de 0,5 s da Tarefa 1) e registra a duração aqui.
+ *
+ *      Para cada tarefa são mantidos:
+ *          - mínimo, máximo e média de todas as execuções;
+ *          - um anel com as últimas PROFILER_AMOSTRAS durações,
+ *            de onde saem percentis exatos da janela recente;
+ *          - um histograma logarítmico (balde b = [2^b, 2^(b+1)) us)
+ *            com todas as execuções, que limita o percentil por cima.
+ *
+ *      O máximo é a estimativa de WCET observada; o p99 do
+ *      histograma dimensiona orçamentos sem depender do anel.
+ *
+ *      Marcos de inicialização: 'profiler_marcar()' guarda uma
+ *      única vez o instante (us desde o reset) de eventos como
+ *      a primeira amostra e o primeiro quadro do OLED, listados
+ *      no início do relatório.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#ifndef PROFILER_MAX_TASKS
+#define PROFILER_MAX_TASKS 12 // Tarefas da tabela + latência de despertar
+#endif
+
+// Tamanho do anel de amostras recentes por tarefa
+#ifndef PROFILER_AMOSTRAS
+#define PROFILER_AMOSTRAS 64
+#endif
+
+// Marcos de inicialização registráveis
+#ifndef PROFILER_MAX_MARCOS
+#define PROFILER_MAX_MARCOS 4
+#endif
+
+// Baldes do histograma: o último acumula tudo acima de 2^(PROFILER_BALDES-1) us
+#define PROFILER_BALDES 24
+
+typedef struct
+{
+    const char *nome;
+    uint32_t n;       // Execuções registradas
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t soma_us; // Para a média
+    uint32_t hist[PROFILER_BALDES];
+    uint32_t anel[PROFILER_AMOSTRAS];
+    uint16_t cabeca;  // Próxima posição do anel
+} profiler_stats_t;
+
+/**
+ * @brief Zera as estatísticas de 'count' tarefas (até PROFILER_MAX_TASKS).
+ */
+void profiler_init(uint count);
+
+/**
+ * @brief Associa um nome à tarefa para o relatório (o ponteiro deve permanecer válido).
+ */
+void profiler_nomear(uint tarefa, const char *nome);
+
+/**
+ * @brief Instante atual em microssegundos, base das durações registradas.
+ */
+static inline uint32_t profiler_agora(void)
+{
+    return time_us_32();
+}
+
+/**
+ * @brief Registra uma execução da tarefa. Chamado pelo despacho, fora de interrupções.
+ */
+void profiler_registrar(uint tarefa, uint32_t duracao_us);
+
+/**
+ * @brief Registra o instante do marco na primeira chamada com este nome; as demais são ignoradas.
+ *
+ * Pode ser chamada de interrupções. Os marcos não são zerados por profiler_init().
+ *
+ * @param nome Nome do marco (o ponteiro identifica o marco e deve permanecer válido)
+ */
+void profiler_marcar(const char *nome);
+
+/**
+ * @brief Estatísticas acumuladas da tarefa (NULL se o índice for inválido).
+ */
+const profiler_stats_t *profiler_stats(uint tarefa);
+
+/**
+ * @brief Percentil exato sobre as amostras do anel (janela recente).
+ *
+ * @param pct Percentil de 1 a 100
+ * @return Duração em us (0 sem amostras)
+ */
+uint32_t profiler_percentil_us(uint tarefa, uint pct);
+
+/**
+ * @brief Limite superior do percentil sobre todas as execuções (histograma).
+ */
+uint32_t profiler_percentil_hist_us(uint tarefa, uint pct);
+
+/**
+ * @brief Imprime min/média/p99/máx de cada tarefa e, opcionalmente, os histogramas.
+ */
+void profiler_relatorio(bool histogramas);
+
+#endif // PROFILER_H
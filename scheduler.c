@@ -0,0 +1,332 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: scheduler.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Escalonador por tabela de tarefas com despacho
+ *      rate-monotonic ou EDF.
+ *
+ *      Cada tarefa possui um alarme próprio, reprogramado
+ *      em relação ao instante teórico da liberação anterior
+ *      (sem deriva acumulada). O callback do alarme apenas
+ *      registra esse instante teórico (base do deadline e do
+ *      jitter, mesmo com atraso do alarme) e marca o bit da
+ *      tarefa no conjunto de prontas; todo o trabalho é
+ *      feito no laço principal por 'scheduler_dispatch()'.
+ *
+ *      Cada despacho é cronometrado e registrado no perfil de
+ *      execução ('profiler.c'), com os nomes da tabela.
+ *
+ *      A mesma medida alimenta a supervisão: overrun contra o
+ *      orçamento, deadline perdido e jitter de liberação. O
+ *      watchdog só é alimentado quando todas as periódicas exigidas
+ *      completaram um ciclo sem falhas; uma falha ativa o modo
+ *      degradado (descarte das tarefas SCHEDULER_TASK_SHEDDABLE).
+ *
+ *      Sem tarefas prontas o núcleo dorme em 'scheduler_idle()'.
+ *      O primeiro despacho após o despertar mede a latência
+ *      liberação → início e a registra no perfil ("despertar",
+ *      índice logo após a última tarefa).
+ *
+ *      O conjunto de prontas e os instantes de liberação são
+ *      compartilhados com o contexto de interrupção, por isso
+ *      toda leitura-modificação-escrita é feita com as
+ *      interrupções desabilitadas (o Cortex-M0+ não possui
+ *      LDREX/STREX).
+ *
+ *  Relacionamento:
+ *      - A tabela de tarefas é definida em 'tarefas.c'.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "scheduler.h"
+#include "profiler.h"
+
+// Estado dinâmico de cada tarefa, atualizado pelo alarme
+typedef struct
+{
+    absolute_time_t release;  // Instante da liberação pendente
+    absolute_time_t deadline; // Deadline absoluto (liberação + período)
+    absolute_time_t next;     // Instante teórico do próximo disparo do alarme (periódicas)
+} scheduler_state_t;
+
+static const scheduler_task_t *task_table;
+static uint task_count;
+static scheduler_state_t task_state[SCHEDULER_MAX_TASKS];
+
+// Conjunto de tarefas prontas: bit i → task_table[i]
+static volatile uint32_t ready_set;
+
+static scheduler_task_stats_t task_stats[SCHEDULER_MAX_TASKS];
+
+// Supervisão de ciclo (laço principal, exceto 'cycle_fault', também marcado no alarme).
+// Falhas das tarefas dispensáveis são contadas, mas não degradam o sistema: elas
+// seriam as únicas descartadas. O mesmo vale para as de fundo, que nem compõem o ciclo.
+static uint32_t periodic_mask; // Periódicas que compõem um ciclo
+static uint32_t shed_mask;     // Tarefas SCHEDULER_TASK_SHEDDABLE
+static uint32_t tolerant_mask; // Falhas apenas contadas: dispensáveis e de fundo
+static uint32_t cycle_done;    // Periódicas executadas no ciclo corrente
+static volatile bool cycle_fault;
+static bool degraded;
+static uint healthy_streak;
+static uint32_t healthy_cycles;
+static bool watchdog_on;
+
+// Ociosidade (laço principal)
+static uint64_t idle_us;
+static bool woke_from_idle;
+
+static void scheduler_release_at(uint index, absolute_time_t release);
+
+/**
+ * @brief Callback do alarme de uma tarefa: registra a liberação.
+ *
+ * A liberação é datada pelo instante teórico do disparo, não pelo
+ * de execução do callback: a latência do alarme não desloca o
+ * deadline e entra no jitter medido. Retorna o período negativo
+ * para que o SDK reagende o alarme a partir desse mesmo instante.
+ */
+static int64_t scheduler_release_callback(alarm_id_t id, void *user_data)
+{
+    uint index = (uint)(uintptr_t)user_data;
+    absolute_time_t release = task_state[index].next;
+
+    task_state[index].next = delayed_by_ms(release, task_table[index].period_ms);
+    scheduler_release_at(index, release);
+    return -((int64_t)task_table[index].period_ms * 1000);
+}
+
+void scheduler_release(uint index)
+{
+    scheduler_release_at(index, get_absolute_time());
+}
+
+/**
+ * @brief Marca a tarefa como pronta, com deadline contado a partir de 'release'.
+ */
+static void scheduler_release_at(uint index, absolute_time_t release)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    if ((ready_set & (1u << index)) && task_table[index].period_ms != 0)
+    {
+        // A liberação anterior ainda não foi despachada: o deadline dela passou
+        task_stats[index].deadline_misses++;
+        if (!(tolerant_mask & (1u << index)))
+            cycle_fault = true;
+    }
+    task_state[index].release = release;
+    // Esporádicas: deadline na própria liberação (atendimento imediato no EDF)
+    task_state[index].deadline = delayed_by_ms(release, task_table[index].period_ms);
+    ready_set |= 1u << index;
+    restore_interrupts(irq);
+}
+
+/**
+ * @brief Indica se a tarefa 'a' deve ser despachada antes da tarefa 'b'.
+ */
+static bool scheduler_precedes(uint a, uint b)
+{
+    const scheduler_task_t *ta = &task_table[a];
+    const scheduler_task_t *tb = &task_table[b];
+
+#if SCHEDULER_POLICY == SCHEDULER_POLICY_EDF
+    int64_t diff = absolute_time_diff_us(task_state[b].deadline, task_state[a].deadline);
+    if (diff != 0)
+        return diff < 0;
+#else
+    if (ta->period_ms != tb->period_ms)
+        return ta->period_ms < tb->period_ms;
+#endif
+
+    return ta->priority < tb->priority;
+}
+
+void scheduler_init(const scheduler_task_t *tasks, uint count)
+{
+    assert(count <= SCHEDULER_MAX_TASKS);
+
+    task_table = tasks;
+    task_count = count;
+    ready_set = 0;
+
+    periodic_mask = 0;
+    shed_mask = 0;
+    tolerant_mask = 0;
+    for (uint i = 0; i < count; i++)
+    {
+        assert(!(tasks[i].flags & SCHEDULER_TASK_SHEDDABLE) || !(tasks[i].flags & SCHEDULER_TASK_BACKGROUND));
+        if (tasks[i].period_ms != 0 && !(tasks[i].flags & SCHEDULER_TASK_BACKGROUND))
+            periodic_mask |= 1u << i;
+        if (tasks[i].flags & SCHEDULER_TASK_SHEDDABLE)
+            shed_mask |= 1u << i;
+        if (tasks[i].flags & (SCHEDULER_TASK_SHEDDABLE | SCHEDULER_TASK_BACKGROUND))
+            tolerant_mask |= 1u << i;
+    }
+
+    profiler_init(count + 1);
+    for (uint i = 0; i < count; i++)
+        profiler_nomear(i, tasks[i].name);
+    profiler_nomear(count, "despertar");
+}
+
+void scheduler_start(void)
+{
+    absolute_time_t start = get_absolute_time();
+
+    for (uint i = 0; i < task_count; i++)
+    {
+        if (task_table[i].period_ms == 0)
+            continue; // Esporádica: liberada por scheduler_release()
+
+        task_state[i].next = delayed_by_ms(start, task_table[i].offset_ms);
+        add_alarm_at(task_state[i].next, scheduler_release_callback, (void *)(uintptr_t)i, true);
+    }
+}
+
+/**
+ * @brief Fecha o ciclo corrente após um despacho: trata falhas e alimenta o watchdog.
+ */
+static void scheduler_supervise(uint index)
+{
+    cycle_done |= 1u << index;
+
+    uint32_t irq = save_and_disable_interrupts();
+    bool fault = cycle_fault;
+    cycle_fault = false;
+    restore_interrupts(irq);
+
+    if (fault)
+    {
+        // Falha no ciclo: sem alimentar o watchdog, descarta as tarefas dispensáveis
+        cycle_done = 0;
+        healthy_streak = 0;
+        degraded = shed_mask != 0;
+        return;
+    }
+
+    uint32_t required = periodic_mask & ~(degraded ? shed_mask : 0);
+    if ((cycle_done & required) != required)
+        return;
+
+    cycle_done = 0;
+    healthy_cycles++;
+    if (watchdog_on)
+        watchdog_update();
+    if (degraded && ++healthy_streak >= SCHEDULER_RECOVERY_CYCLES)
+        degraded = false;
+}
+
+bool scheduler_dispatch(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    if (degraded && (ready_set & shed_mask))
+    {
+        uint32_t shed = ready_set & shed_mask;
+        for (uint i = 0; i < task_count; i++)
+            if (shed & (1u << i))
+                task_stats[i].shed++;
+        ready_set &= ~shed_mask;
+    }
+    uint32_t ready = ready_set;
+
+    if (ready == 0)
+    {
+        restore_interrupts(irq);
+        return false;
+    }
+
+    uint best = task_count;
+    for (uint i = 0; i < task_count; i++)
+    {
+        if ((ready & (1u << i)) && (best == task_count || scheduler_precedes(i, best)))
+            best = i;
+    }
+    ready_set &= ~(1u << best);
+    absolute_time_t release = task_state[best].release;
+    absolute_time_t deadline = task_state[best].deadline;
+    restore_interrupts(irq);
+
+    const scheduler_task_t *task = &task_table[best];
+    scheduler_task_stats_t *stats = &task_stats[best];
+    absolute_time_t start = get_absolute_time();
+
+    uint32_t inicio = profiler_agora();
+    task->entry();
+    uint32_t duracao_us = profiler_agora() - inicio;
+    profiler_registrar(best, duracao_us);
+
+    uint32_t jitter_us = (uint32_t)absolute_time_diff_us(release, start);
+    if (woke_from_idle)
+    {
+        woke_from_idle = false;
+        profiler_registrar(task_count, jitter_us); // Latência de despertar
+    }
+    stats->jitter_last_us = jitter_us;
+    if (jitter_us > stats->jitter_max_us)
+        stats->jitter_max_us = jitter_us;
+
+    if (task->budget_us != 0 && duracao_us > task->budget_us)
+    {
+        stats->overruns++;
+        if (!(tolerant_mask & (1u << best)))
+            cycle_fault = true;
+    }
+    if (task->period_ms != 0 && absolute_time_diff_us(deadline, get_absolute_time()) > 0)
+    {
+        stats->deadline_misses++;
+        if (!(tolerant_mask & (1u << best)))
+            cycle_fault = true;
+    }
+
+    scheduler_supervise(best);
+    return true;
+}
+
+void scheduler_watchdog_enable(void)
+{
+    watchdog_enable(SCHEDULER_WATCHDOG_MS, true); // Pausa durante a depuração
+    watchdog_on = true;
+}
+
+const scheduler_task_stats_t *scheduler_stats(uint index)
+{
+    return index < task_count ? &task_stats[index] : NULL;
+}
+
+bool scheduler_degraded(void)
+{
+    return degraded;
+}
+
+uint32_t scheduler_healthy_cycles(void)
+{
+    return healthy_cycles;
+}
+
+void scheduler_idle(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    if (ready_set != 0)
+    {
+        restore_interrupts(irq);
+        return;
+    }
+
+    uint32_t inicio = profiler_agora();
+    __wfi(); // Uma interrupção pendente acorda o núcleo mesmo mascarada
+    idle_us += profiler_agora() - inicio;
+    woke_from_idle = true;
+    restore_interrupts(irq); // O alarme que acordou o núcleo é atendido aqui
+}
+
+uint64_t scheduler_idle_us(void)
+{
+    return idle_us;
+}
@@ -0,0 +1,170 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: scheduler.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface do escalonador por tabela de tarefas.
+ *
+ *      Cada tarefa é descrita por uma entrada estática
+ *      (período, offset, orçamento, prioridade e função).
+ *      As liberações são geradas por alarmes do timer e
+ *      marcadas num conjunto de prontas (bitmask); o laço
+ *      principal despacha a tarefa pronta de maior prioridade
+ *      segundo a política escolhida:
+ *
+ *          - SCHEDULER_POLICY_RM  → rate-monotonic (menor período
+ *                                   primeiro, desempate por prioridade)
+ *          - SCHEDULER_POLICY_EDF → earliest-deadline-first
+ *                                   (deadline = liberação + período)
+ *
+ *      Tarefas com período 0 são esporádicas: não têm alarme e
+ *      são liberadas por evento com 'scheduler_release()' (por
+ *      exemplo, a partir de uma interrupção). Elas precedem as
+ *      periódicas nas duas políticas.
+ *
+ *      Supervisão: o despacho mede o atraso entre liberação e
+ *      início (jitter), conta execuções acima do orçamento
+ *      (overrun) e deadlines perdidos (término após o deadline ou
+ *      nova liberação antes do despacho). Um ciclo saudável, isto
+ *      é, com todas as periódicas executadas ao menos uma vez e
+ *      sem falhas, alimenta o watchdog. Uma falha coloca o sistema
+ *      em modo degradado, que descarta as tarefas marcadas com
+ *      SCHEDULER_TASK_SHEDDABLE até SCHEDULER_RECOVERY_CYCLES
+ *      ciclos saudáveis seguidos. Se as falhas persistirem, o
+ *      watchdog deixa de ser alimentado e reinicia o sistema.
+ *      Tarefas SCHEDULER_TASK_BACKGROUND (drenagem de registros,
+ *      manutenção) ficam fora da supervisão: não compõem o ciclo
+ *      e suas falhas são apenas contadas, mas nunca são
+ *      descartadas.
+ *
+ *      Ociosidade: sem tarefas prontas, 'scheduler_idle()' dorme
+ *      com '__wfi()' até a próxima interrupção (em geral o alarme
+ *      da próxima liberação). A latência entre a liberação e o
+ *      início do despacho após o despertar é registrada no
+ *      perfil como a entrada "despertar".
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#define SCHEDULER_POLICY_RM 0
+#define SCHEDULER_POLICY_EDF 1
+
+#ifndef SCHEDULER_POLICY
+#define SCHEDULER_POLICY SCHEDULER_POLICY_RM
+#endif
+
+// Limite dado pela largura do conjunto de prontas (uint32_t)
+#define SCHEDULER_MAX_TASKS 32
+
+// Tempo sem ciclo saudável até o reset (maior período + janela da Tarefa 1, com folga)
+#ifndef SCHEDULER_WATCHDOG_MS
+#define SCHEDULER_WATCHDOG_MS 4000
+#endif
+
+// Ciclos saudáveis seguidos para sair do modo degradado
+#ifndef SCHEDULER_RECOVERY_CYCLES
+#define SCHEDULER_RECOVERY_CYCLES 5
+#endif
+
+// Flags de tarefa
+#define SCHEDULER_TASK_SHEDDABLE 0x01   // Descartada no modo degradado (nunca em alertas: a falha é o momento deles)
+#define SCHEDULER_TASK_BACKGROUND 0x02  // Fora do ciclo supervisionado; falhas apenas contadas
+
+typedef void (*scheduler_entry_t)(void);
+
+// Descrição estática de uma tarefa periódica
+typedef struct
+{
+    const char *name;
+    uint32_t period_ms; // Período de liberação (0 = esporádica)
+    uint32_t offset_ms; // Atraso da primeira liberação em relação ao start
+    uint32_t budget_us; // Tempo de execução previsto (WCET)
+    uint8_t priority;   // Menor valor = maior prioridade
+    scheduler_entry_t entry;
+    uint8_t flags;      // SCHEDULER_TASK_*
+} scheduler_task_t;
+
+// Contadores de supervisão de uma tarefa
+typedef struct
+{
+    uint32_t deadline_misses; // Término após o deadline ou liberação sobreposta
+    uint32_t overruns;        // Execuções acima de budget_us
+    uint32_t shed;            // Liberações descartadas no modo degradado
+    uint32_t jitter_last_us;  // Atraso liberação → início da última execução
+    uint32_t jitter_max_us;
+} scheduler_task_stats_t;
+
+/**
+ * @brief Registra a tabela de tarefas (deve permanecer válida enquanto o escalonador rodar).
+ *
+ * @param tasks Vetor de tarefas
+ * @param count Número de tarefas (até SCHEDULER_MAX_TASKS)
+ */
+void scheduler_init(const scheduler_task_t *tasks, uint count);
+
+/**
+ * @brief Arma os alarmes de todas as tarefas a partir do instante atual.
+ */
+void scheduler_start(void);
+
+/**
+ * @brief Libera uma tarefa por evento. Pode ser chamada de uma interrupção.
+ *
+ * A liberação é datada pelo instante da chamada.
+ *
+ * @param index Índice da tarefa na tabela
+ */
+void scheduler_release(uint index);
+
+/**
+ * @brief Despacha a tarefa pronta de maior prioridade, se houver.
+ *
+ * @return true se alguma tarefa foi executada
+ */
+bool scheduler_dispatch(void);
+
+/**
+ * @brief Habilita o watchdog com SCHEDULER_WATCHDOG_MS; a partir daí ele só é
+ * alimentado ao fim de cada ciclo saudável.
+ */
+void scheduler_watchdog_enable(void);
+
+/**
+ * @brief Contadores de supervisão da tarefa (NULL se o índice for inválido).
+ */
+const scheduler_task_stats_t *scheduler_stats(uint index);
+
+/**
+ * @brief Indica se o escalonador está descartando as tarefas SCHEDULER_TASK_SHEDDABLE.
+ */
+bool scheduler_degraded(void);
+
+/**
+ * @brief Ciclos saudáveis completados (cada um alimentou o watchdog).
+ */
+uint32_t scheduler_healthy_cycles(void);
+
+/**
+ * @brief Dorme até a próxima interrupção se nenhuma tarefa estiver pronta.
+ *
+ * A verificação e o '__wfi()' ocorrem com as interrupções mascaradas: uma
+ * liberação que chegue entre os dois ainda acorda o núcleo.
+ */
+void scheduler_idle(void);
+
+/**
+ * @brief Tempo total dormindo em 'scheduler_idle()', em microssegundos.
+ */
+uint64_t scheduler_idle_us(void);
+
+#endif // SCHEDULER_H
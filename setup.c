@@ -11,18 +11,29 @@
  *      - Configuração do ADC e habilitação do sensor interno
  *      - Configuração do canal DMA para leitura da temperatura
  *      - Registro da interrupção do canal DMA 0
- *      - Inicialização do display OLED (SSD1306)
+ *      - Reserva dos canais DMA 0 e 1 da Tarefa 1, antes que os
+ *        drivers do OLED e da NeoPixel peçam canais livres
+ *      - Inicialização do display OLED (SSD1306) e do canal
+ *        DMA do envio assíncrono do framebuffer (DMA_IRQ_1)
  *
  *      A função principal `setup()` deve ser chamada uma única
  *      vez no início do programa, geralmente logo no `main()`,
  *      para garantir que o sistema esteja corretamente preparado
  *      antes de iniciar o executor cíclico.
  *
+ *      Para uma partida escalonada, as mesmas etapas estão
+ *      disponíveis separadamente e não bloqueiam: primeiro
+ *      'setup_aquisicao()' (a Tarefa 1 já pode amostrar) e
+ *      depois, em qualquer ordem, 'setup_display()' (a
+ *      inicialização do OLED segue pelo DMA do framebuffer),
+ *      'setup_neopixel()' e 'setup_stdio()'.
+ *
  *  Relacionamento:
  *      - Define a configuração global `cfg_temp` para uso
  *        posterior na Tarefa 1 (tarefa1_temp.c)
- *      - Define os símbolos globais `ssd[]` e `area` usados na
- *        Tarefa 2 (tarefa2_display.c)
+ *      - Define o par de framebuffers do OLED (frente/trás,
+ *        acessado pela Tarefa 2 via 'ssd1306_back_buffer()') e
+ *        o símbolo global `area`
  *      - Utiliza o handler de interrupção definido em
  *        'irq_handlers.c'
  *
@@ -43,8 +54,9 @@
 #include "pico/binary_info.h"
 #include "neopixel_driver.h"
 
-// === Buffer de vídeo do OLED (tela de 128 x 64) ===
-uint8_t ssd[ssd1306_buffer_length];
+// === Buffers de vídeo do OLED (tela de 128 x 64): par frente/trás ===
+// O byte de controle 0x40 fica à frente de cada framebuffer, permitindo enviá-lo sem cópia
+static uint8_t ssd_frames[2][ssd1306_frame_length] = {{0x40}, {0x40}};
 
 // === Área de renderização usada por render_on_display() ===
 struct render_area area = {
@@ -57,15 +69,35 @@ struct render_area area = {
 dma_channel_config cfg_temp;
 
 /**
- * @brief Realiza a configuração inicial do sistema.
- *
- * Esta função inicializa o terminal USB, ADC, sensor de temperatura,
- * canal DMA 0, interrupções e o display OLED.
+ * @brief Inicializa a comunicação USB para printf().
  */
-void setup()
+void setup_stdio()
 {
-    // Inicializa a comunicação USB para printf()
     stdio_init_all();
+}
+
+/**
+ * @brief Reserva os canais DMA usados diretamente pela Tarefa 1 (uma única vez).
+ *
+ * Os drivers do OLED e da NeoPixel pedem canais livres com
+ * 'dma_claim_unused_channel()', que começa pelo canal 0: toda etapa
+ * que inicializa um deles chama esta função antes, em qualquer ordem.
+ */
+static void reservar_canais_temp(void)
+{
+    if (dma_channel_is_claimed(DMA_TEMP_CHANNEL))
+        return;
+
+    dma_channel_claim(DMA_TEMP_CHANNEL);
+    dma_channel_claim(DMA_TEMP_CHANNEL_B); // Ping-pong e streaming, mesmo sem uso nos demais modos
+}
+
+/**
+ * @brief Prepara o ADC, o sensor de temperatura, o canal DMA 0 e sua interrupção.
+ */
+void setup_aquisicao()
+{
+    reservar_canais_temp();
 
     // Inicializa o ADC do RP2040 e habilita o sensor interno (canal 4)
     adc_init();
@@ -78,11 +110,20 @@ void setup()
     channel_config_set_write_increment(&cfg_temp, true);           // Buffer se move
     channel_config_set_dreq(&cfg_temp, DREQ_ADC);                  // dispara com ADC
 
+#if !TAREFA1_DUAL_CORE
     // Configura interrupção do canal DMA 0
+    // (no modo dual-core isso é feito pelo núcleo 1, que consome a IRQ)
     dma_channel_set_irq0_enabled(DMA_TEMP_CHANNEL, true);
     irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
     irq_set_enabled(DMA_IRQ_0, true);
+#endif
+}
 
+/**
+ * @brief Configura o I2C e enfileira a inicialização do OLED no DMA, sem esperar o envio.
+ */
+void setup_display()
+{
     // Inicializa o display OLED SSD1306 via I2C
     i2c_init(i2c1, 400 * 1000); // <---I2C primeiro
     gpio_set_function(14, GPIO_FUNC_I2C);
@@ -90,9 +131,34 @@ void setup()
     gpio_pull_up(14);
     gpio_pull_up(15);
 
-    ssd1306_init(); // <---Depois do I2C estar pronto
+    reservar_canais_temp(); // O canal do envio não pode ser o da Tarefa 1
+    ssd1306_dma_init(); // Envio do framebuffer por DMA (render_on_display_async)
+    ssd1306_init_async(); // <---Depois do I2C estar pronto; os quadros seguem na fila
+    ssd1306_double_buffer_init(&ssd_frames[0][1], &ssd_frames[1][1]);
     calculate_render_area_buffer_length(&area);
+}
 
-    // Inicializa NeoPixel (Matriz RGB)
+/**
+ * @brief Inicializa NeoPixel (Matriz RGB).
+ */
+void setup_neopixel()
+{
+    reservar_canais_temp(); // O canal da matriz não pode ser o parceiro do ping-pong/streaming
     npInit(LED_PIN); // substitua LED_PIN pelo valor real, ex: 7
+}
+
+/**
+ * @brief Realiza a configuração inicial do sistema.
+ *
+ * Esta função inicializa o terminal USB, ADC, sensor de temperatura,
+ * canal DMA 0, interrupções, o display OLED e a matriz NeoPixel,
+ * aguardando o fim da inicialização do OLED.
+ */
+void setup()
+{
+    setup_stdio();
+    setup_aquisicao();
+    setup_display();
+    ssd1306_flush_wait();
+    setup_neopixel();
 }
\ No newline at end of file
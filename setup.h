@@ -4,9 +4,17 @@
 #include "hardware/dma.h"
 
 #define DMA_TEMP_CHANNEL 0
+#define DMA_TEMP_CHANNEL_B 1 // Parceiro do canal 0 (ping-pong) ou canal de controle (streaming)
 
 extern dma_channel_config cfg_temp;
 
+// Todas as etapas em sequência, aguardando o OLED
 void setup(void);
 
+// Etapas da partida escalonada: a aquisição primeiro, as demais sem bloquear
+void setup_aquisicao(void);
+void setup_display(void);
+void setup_neopixel(void);
+void setup_stdio(void);
+
 #endif
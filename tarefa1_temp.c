@@ -22,6 +22,83 @@
  *      - Utiliza DMA canal 0 e depende da flag 'dma_temp_done'
  *        sinalizada pelo handler definido em 'irq_handlers.c'.
  *
+ *      A aquisição é assíncrona: 'tarefa1_start()' abre a janela,
+ *      'tarefa1_poll()' processa cada bloco que o DMA concluiu e
+ *      dispara o próximo, e 'tarefa1_result()' devolve a média.
+ *      'tarefa1_obter_media_temp()' é a versão bloqueante.
+ *
+ *      Taxa do ADC, janela e sobreamostragem são definidas em
+ *      tempo de execução por 'tarefa1_configurar()' (struct
+ *      'tarefa1_config_t'). A janela passa a ser contada em
+ *      amostras (taxa × duração), o que torna o tempo da tarefa
+ *      determinístico. O estágio de decimação é um boxcar: cada
+ *      saída é a média de 'sobreamostragem' amostras seguidas do
+ *      ADC, que roda a taxa × sobreamostragem; a última saída de
+ *      cada bloco fica disponível em 'tarefa1_ultima_saida()'.
+ *      O ADC fica entre 733 Hz (divisor de 16 bits) e 500 kHz:
+ *      abaixo do mínimo a sobreamostragem é aumentada, e a taxa
+ *      de saída efetivamente aplicada é informada por
+ *      'tarefa1_taxa_saida_hz()'.
+ *
+ *      A acumulação é configurável (TAREFA1_ACUMULACAO):
+ *          - TAREFA1_ACUM_INTEIRA (padrão): soma os códigos brutos
+ *            de 12 bits em inteiro de 64 bits e converte para °C
+ *            uma única vez no final (a conversão é afim, logo a
+ *            média converte igual à média das conversões);
+ *          - TAREFA1_ACUM_LUT: soma valores por amostra obtidos de
+ *            uma tabela de 4096 entradas em ponto fixo (1/16 °C);
+ *          - TAREFA1_ACUM_FLOAT: conversão em float por amostra
+ *            (comportamento original, mantido para comparação).
+ *
+ *      Com TAREFA1_SNIFFER=1 a soma é feita pelo hardware: o
+ *      sniffer do DMA (modo soma de 32 bits) acumula cada
+ *      amostra lida de 'adc_hw->fifo' e a tarefa apenas lê o
+ *      acumulador ao fim de cada bloco. As amostras vão para
+ *      uma única palavra de descarte, dispensando o buffer.
+ *      Requer a acumulação inteira e o modo por blocos.
+ *
+ *      Com TAREFA1_PING_PONG=1 o ADC roda livremente e dois
+ *      canais DMA encadeados (DMA_TEMP_CHANNEL e
+ *      DMA_TEMP_CHANNEL_B) alternam entre as duas metades do
+ *      buffer: enquanto uma metade enche, a outra é somada,
+ *      sem perder amostras entre blocos nem reconfigurar o ADC.
+ *
+ *      Com TAREFA1_STREAMING=1 o buffer vira um anel pequeno
+ *      (TAREFA1_BLOCO_AMOSTRAS, padrão 256 amostras = 512 bytes)
+ *      com wrap de escrita feito pelo próprio DMA. Um canal de
+ *      controle (DMA_TEMP_CHANNEL_B) redispara o canal de dados
+ *      a cada meio anel, sem intervenção da CPU; a interrupção
+ *      de cada meio anel marca a metade pronta, como no
+ *      ping-pong. A média é a mesma com um buffer ~40x menor
+ *      (512 bytes contra 20 KB). O anel não encolhe mais porque
+ *      a CPU precisa somar cada meio anel antes que ele volte a
+ *      ser escrito: a 500 kS/s, 128 amostras dão uma interrupção
+ *      a cada 256 us, e cada redução à metade dobra essa taxa.
+ *      Ao contrário do ping-pong, o anel só roda durante a
+ *      janela: ao completá-la, o ADC e os canais são parados,
+ *      sem interrupções entre uma janela e a seguinte.
+ *
+ *      Com TAREFA1_ROUND_ROBIN=1 o ADC alterna entre as entradas
+ *      de 'tarefa1_config_t.canais' (adc_set_round_robin) e um
+ *      único fluxo DMA captura as amostras intercaladas. Cada
+ *      bloco é separado por canal numa só passada, acumulando
+ *      uma média por entrada ('tarefa1_media_canal()'); a média
+ *      de temperatura continua vindo do sensor interno (ADC4).
+ *      A taxa configurada passa a ser por canal. Requer a
+ *      acumulação inteira e um modo com buffer (não o sniffer).
+ *
+ *      Monitor de limiares: a média de cada bloco (ou metade)
+ *      concluído passa por um comparador com histerese
+ *      ('tarefa1_configurar_limiares()'). Ao cruzar um limiar,
+ *      ou ao voltar à faixa normal, 'tarefa1_alerta_notificar'
+ *      é chamada uma vez, no mesmo contexto que processou o
+ *      bloco; o alerta não espera o fim da janela.
+ *
+ *      Com TAREFA1_DUAL_CORE=1 a aquisição roda continuamente
+ *      no núcleo 1 e cada média concluída é publicada ao
+ *      núcleo 0 pelo FIFO do SIO; a tarefa no núcleo 0 apenas
+ *      consome o resultado mais recente.
+ *
  *  Relacionamento:
  *      - Chamado pelo laço principal em 'main.c' como tarefa do ciclo.
  *      - Requer configuração do canal DMA e IRQ em 'setup.c'.
@@ -37,50 +114,854 @@
 #include "hardware/sync.h"
 #include "tarefa1_temp.h"
 
-#define BLOCO_AMOSTRAS 10000
-#define DURACAO_AMOSTRAGEM_US 500000 // 0,5 segundos em microssegundos
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+#include "setup.h" // DMA_TEMP_CHANNEL_B
+#include "irq_handlers.h"
+#endif
+
+#if TAREFA1_DUAL_CORE
+#include <string.h>
+#include "pico/multicore.h"
+#include "hardware/irq.h"
+#include "irq_handlers.h"
+#if HISTORICO
+#include "pico/flash.h"
+#endif
+#endif
+
+// Tamanho do bloco (ou do anel, no modo streaming) definido no build
+#ifndef TAREFA1_BLOCO_AMOSTRAS
+#if TAREFA1_STREAMING
+#define TAREFA1_BLOCO_AMOSTRAS 256
+#else
+#define TAREFA1_BLOCO_AMOSTRAS 10000
+#endif
+#endif
 
+#define BLOCO_AMOSTRAS TAREFA1_BLOCO_AMOSTRAS
+
+#if TAREFA1_STREAMING
+#if TAREFA1_PING_PONG
+#error "TAREFA1_STREAMING e TAREFA1_PING_PONG são modos alternativos de aquisição livre"
+#endif
+#define ANEL_BYTES (BLOCO_AMOSTRAS * sizeof(uint16_t))
+_Static_assert((BLOCO_AMOSTRAS & (BLOCO_AMOSTRAS - 1)) == 0, "o anel do DMA precisa ter tamanho potência de 2");
+_Static_assert(ANEL_BYTES <= (1u << 15), "o wrap do DMA suporta anéis de até 32 KB");
+#endif
+
+#define ADC_CLOCK_HZ 48000000u // clk_adc
+#define ADC_TAXA_MAXIMA_HZ 500000u // 96 ciclos por conversão
+#define ADC_TAXA_MINIMA_HZ 733u    // Parte inteira do divisor com 16 bits: 48 MHz / 65536, para cima
+
+// A partir de 1: um nome desconhecido vindo do build vale 0 no '#if' e cai no '#error' abaixo
+#define TAREFA1_ACUM_INTEIRA 1
+#define TAREFA1_ACUM_LUT 2
+#define TAREFA1_ACUM_FLOAT 3
+
+#ifndef TAREFA1_ACUMULACAO
+#define TAREFA1_ACUMULACAO TAREFA1_ACUM_INTEIRA
+#endif
+
+#if TAREFA1_ACUMULACAO != TAREFA1_ACUM_INTEIRA && TAREFA1_ACUMULACAO != TAREFA1_ACUM_LUT && \
+    TAREFA1_ACUMULACAO != TAREFA1_ACUM_FLOAT
+#error "TAREFA1_ACUMULACAO deve ser TAREFA1_ACUM_INTEIRA, TAREFA1_ACUM_LUT ou TAREFA1_ACUM_FLOAT"
+#endif
+
+#define LUT_FRAC_BITS 4 // Entradas da LUT em 1/16 °C
+
+#if TAREFA1_ROUND_ROBIN && TAREFA1_ACUMULACAO != TAREFA1_ACUM_INTEIRA
+#error "TAREFA1_ROUND_ROBIN acumula códigos brutos por canal: use TAREFA1_ACUMULACAO=INTEIRA"
+#endif
+
+#if TAREFA1_SNIFFER
+#if TAREFA1_ACUMULACAO != TAREFA1_ACUM_INTEIRA
+#error "TAREFA1_SNIFFER soma códigos brutos: use TAREFA1_ACUMULACAO=INTEIRA"
+#endif
+#if TAREFA1_PING_PONG
+#error "TAREFA1_SNIFFER acompanha um único canal: incompatível com TAREFA1_PING_PONG"
+#endif
+#if TAREFA1_STREAMING
+#error "TAREFA1_SNIFFER não usa buffer: TAREFA1_STREAMING é desnecessário"
+#endif
+_Static_assert((uint64_t)BLOCO_AMOSTRAS * 4095 <= UINT32_MAX, "bloco excede o acumulador do sniffer");
+#if TAREFA1_ROUND_ROBIN
+#error "TAREFA1_ROUND_ROBIN separa as amostras por canal: incompatível com TAREFA1_SNIFFER"
+#endif
+
+// Destino fixo das transferências: as amostras só interessam ao sniffer
+static uint32_t descarte_sniffer;
+#elif TAREFA1_STREAMING
+// O wrap de escrita exige o anel alinhado ao próprio tamanho
+static uint16_t buffer_temp[BLOCO_AMOSTRAS] __attribute__((aligned(ANEL_BYTES)));
+#else
 static uint16_t buffer_temp[BLOCO_AMOSTRAS];
+#endif
 extern volatile bool dma_temp_done;
 
 /**
  * @brief Converte valor do ADC para temperatura em °C.
  *
- * @param raw Valor bruto de 12 bits lido do ADC.
+ * Aceita valor fracionário para converter diretamente a média
+ * dos códigos brutos.
+ *
+ * @param raw Valor bruto de 12 bits lido do ADC (ou média deles).
  * @return float Temperatura em graus Celsius.
  */
-static float convert_to_celsius(uint16_t raw)
+static float convert_to_celsius(float raw)
 {
     const float conv = 3.3f / (1 << 12); // Conversão para tensão
     float voltage = raw * conv;
     return 27.0f - (voltage - 0.706f) / 0.001721f;
 }
 
+#if TAREFA1_ACUMULACAO == TAREFA1_ACUM_FLOAT
+typedef float soma_t;
+#else
+typedef int64_t soma_t;
+#endif
+
+#if TAREFA1_ACUMULACAO == TAREFA1_ACUM_LUT
+// Temperatura de cada código do ADC em ponto fixo (1/16 °C cabe em int16)
+static int16_t lut_celsius[1 << 12];
+static bool lut_pronta = false;
+
+static void gerar_lut_celsius(void)
+{
+    for (uint raw = 0; raw < count_of(lut_celsius); raw++)
+    {
+        float celsius = convert_to_celsius((float)raw) * (1 << LUT_FRAC_BITS);
+        lut_celsius[raw] = (int16_t)(celsius < 0 ? celsius - 0.5f : celsius + 0.5f);
+    }
+    lut_pronta = true;
+}
+#endif
+
+/**
+ * @brief Acumula um bloco de amostras conforme TAREFA1_ACUMULACAO.
+ *
+ * @param buffer Amostras brutas do ADC.
+ * @param n Número de amostras.
+ * @return soma_t Soma dos códigos brutos, dos valores da LUT ou das temperaturas em °C.
+ */
+static soma_t somar_bloco(const uint16_t *buffer, uint n)
+{
+#if TAREFA1_ACUMULACAO == TAREFA1_ACUM_FLOAT
+    float soma = 0.0f;
+    for (uint i = 0; i < n; i++)
+    {
+        soma += convert_to_celsius(buffer[i]);
+    }
+    return soma;
+#elif TAREFA1_ACUMULACAO == TAREFA1_ACUM_LUT
+    int32_t soma = 0; // 10.000 × |-23.664| cabe em 32 bits
+    for (uint i = 0; i < n; i++)
+    {
+        soma += lut_celsius[buffer[i] & 0x0FFF];
+    }
+    return soma;
+#else
+    uint32_t soma = 0; // 10.000 × 4095 cabe em 32 bits; o total da janela usa 64
+    for (uint i = 0; i < n; i++)
+    {
+        soma += buffer[i];
+    }
+    return soma;
+#endif
+}
+
+/**
+ * @brief Converte o acumulado da janela na temperatura média em °C.
+ *
+ * @param soma Acumulado das chamadas de somar_bloco().
+ * @param total_amostras Número de amostras acumuladas.
+ * @return float Temperatura média.
+ */
+static float media_celsius(soma_t soma, uint32_t total_amostras)
+{
+#if TAREFA1_ACUMULACAO == TAREFA1_ACUM_FLOAT
+    return soma / total_amostras;
+#elif TAREFA1_ACUMULACAO == TAREFA1_ACUM_LUT
+    return (float)soma / ((float)total_amostras * (1 << LUT_FRAC_BITS));
+#else
+    return convert_to_celsius((float)soma / total_amostras);
+#endif
+}
+
+// Configuração corrente e última saída do decimador (código bruto médio)
+static tarefa1_config_t config = TAREFA1_CONFIG_PADRAO;
+static float ultima_saida_raw = 0.0f;
+
+// Monitor de limiares
+static tarefa1_limiares_t limiares = TAREFA1_LIMIARES_PADRAO;
+static volatile bool alerta_ativo = false;
+void (*volatile tarefa1_alerta_notificar)(bool ativo) = NULL;
+
+/**
+ * @brief Comparador com histerese aplicado à média de um bloco.
+ *
+ * Arma fora de [baixo, alto] e só desarma dentro de
+ * [baixo + histerese, alto - histerese]; notifica apenas as mudanças.
+ *
+ * @param celsius Temperatura média do bloco.
+ */
+static void monitorar_bloco(float celsius)
+{
+    bool ativo;
+    if (alerta_ativo)
+        ativo = celsius < limiares.baixo_c + limiares.histerese_c ||
+                celsius > limiares.alto_c - limiares.histerese_c;
+    else
+        ativo = celsius < limiares.baixo_c || celsius > limiares.alto_c;
+
+    if (ativo == alerta_ativo)
+        return;
+
+    alerta_ativo = ativo;
+    if (tarefa1_alerta_notificar)
+        tarefa1_alerta_notificar(ativo);
+}
+
+#if TAREFA1_ROUND_ROBIN
+// Ordem de conversão do round-robin: posição na sequência → entrada do ADC
+static uint8_t rr_ordem[TAREFA1_N_CANAIS] = {TAREFA1_CANAL_SENSOR};
+static uint rr_n = 1;
+static uint rr_posicao_sensor = 0;
+
+/**
+ * @brief Monta a sequência de conversão a partir da máscara de canais.
+ *
+ * O ADC avança para a próxima entrada da máscara em ordem crescente,
+ * voltando à menor; a sequência começa pela menor entrada.
+ */
+static void montar_ordem_round_robin(void)
+{
+    config.canais = (config.canais | TAREFA1_CANAL_BIT(TAREFA1_CANAL_SENSOR)) &
+                    (TAREFA1_CANAL_BIT(TAREFA1_N_CANAIS) - 1);
+    rr_n = 0;
+    for (uint canal = 0; canal < TAREFA1_N_CANAIS; canal++)
+    {
+        if (config.canais & TAREFA1_CANAL_BIT(canal))
+        {
+            if (canal == TAREFA1_CANAL_SENSOR)
+                rr_posicao_sensor = rr_n;
+            rr_ordem[rr_n++] = canal;
+        }
+    }
+}
+
+static inline uint canais_ativos(void)
+{
+    return rr_n;
+}
+#else
+static inline uint canais_ativos(void)
+{
+    return 1;
+}
+#endif
+
+/**
+ * @brief Seleciona as entradas do ADC antes de ligá-lo.
+ *
+ * Deve ser chamada com o ADC parado: a seleção da primeira entrada
+ * alinha a sequência do round-robin com o início do buffer.
+ */
+static void selecionar_entradas_adc(void)
+{
+#if TAREFA1_ROUND_ROBIN
+    for (uint canal = 0; canal < TAREFA1_CANAL_SENSOR; canal++)
+    {
+        if (config.canais & TAREFA1_CANAL_BIT(canal))
+            adc_gpio_init(26 + canal); // ADCn → GPIO 26 + n
+    }
+    adc_select_input(rr_ordem[0]);
+    adc_set_round_robin(rr_n > 1 ? config.canais : 0);
+#else
+    adc_select_input(TAREFA1_CANAL_SENSOR); // Canal 4 → sensor interno
+#endif
+}
+
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+static void parar_pingpong_temp(void);
+#endif
+
+/**
+ * @brief Amostras de uma saída decimada completa (de todos os canais no round-robin).
+ */
+static inline uint passo_amostras(void)
+{
+    return config.sobreamostragem * canais_ativos();
+}
+
+/**
+ * @brief Taxa efetiva de conversão do ADC (saída × sobreamostragem, limitada ao alcance do divisor).
+ */
+static uint32_t taxa_adc_hz(void)
+{
+    if (config.taxa_hz == 0)
+        return ADC_TAXA_MAXIMA_HZ;
+
+    uint64_t taxa = (uint64_t)config.taxa_hz * passo_amostras(); // Até 2^32 × BLOCO_AMOSTRAS / 2
+    if (taxa > ADC_TAXA_MAXIMA_HZ)
+        return ADC_TAXA_MAXIMA_HZ;
+    return taxa < ADC_TAXA_MINIMA_HZ ? ADC_TAXA_MINIMA_HZ : (uint32_t)taxa;
+}
+
+/**
+ * @brief Programa o divisor do ADC para a taxa configurada.
+ *
+ * Cada conversão dura (1 + div) ciclos de clk_adc, com mínimo de 96.
+ */
+static void aplicar_taxa_adc(void)
+{
+    uint32_t taxa = taxa_adc_hz();
+    adc_set_clkdiv(taxa >= ADC_TAXA_MAXIMA_HZ ? 0.0f : (float)ADC_CLOCK_HZ / taxa - 1.0f);
+}
+
+/**
+ * @brief Número de amostras do ADC que compõem uma janela.
+ */
+static uint32_t amostras_da_janela(void)
+{
+    uint passo = passo_amostras();
+    uint64_t n = (uint64_t)taxa_adc_hz() * config.janela_us / 1000000u;
+    n -= n % passo; // Janela com saídas decimadas completas
+    return n < passo ? passo : (uint32_t)n;
+}
+
+/**
+ * @brief Tamanho do próximo bloco: até 'maximo', múltiplo do passo de decimação.
+ */
+static uint tamanho_bloco(uint32_t restantes, uint maximo)
+{
+    uint n = restantes < maximo ? restantes : maximo;
+    return n - n % passo_amostras();
+}
+
+#if !TAREFA1_SNIFFER
+/**
+ * @brief Estágio boxcar: a saída decimada é a média das últimas N amostras do bloco.
+ *
+ * @param fim Ponteiro para o fim do bloco.
+ */
+static void registrar_saida_boxcar(const uint16_t *fim)
+{
+    uint32_t soma = 0;
+    for (uint i = 1; i <= config.sobreamostragem; i++)
+    {
+        soma += fim[-(int)i];
+    }
+    ultima_saida_raw = (float)soma / config.sobreamostragem;
+}
+#endif
+
+void tarefa1_configurar(const tarefa1_config_t *cfg)
+{
+    config = *cfg;
+    if (config.sobreamostragem == 0)
+        config.sobreamostragem = 1;
+#if TAREFA1_ROUND_ROBIN
+    montar_ordem_round_robin();
+#endif
+    // Abaixo do alcance do divisor, mais amostras por saída mantêm a taxa de saída pedida
+    if (config.taxa_hz && (uint64_t)config.taxa_hz * passo_amostras() < ADC_TAXA_MINIMA_HZ)
+    {
+        uint32_t taxa_canais = config.taxa_hz * canais_ativos(); // < ADC_TAXA_MINIMA_HZ
+        config.sobreamostragem = (ADC_TAXA_MINIMA_HZ + taxa_canais - 1) / taxa_canais;
+    }
+    if (passo_amostras() > BLOCO_AMOSTRAS / 2)
+        config.sobreamostragem = BLOCO_AMOSTRAS / (2 * canais_ativos());
+    if (config.janela_us == 0)
+        config.janela_us = TAREFA1_CONFIG_PADRAO_JANELA_US;
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+    parar_pingpong_temp(); // Reinicia na próxima janela com a nova taxa
+#endif
+}
+
+float tarefa1_taxa_saida_hz(void)
+{
+    return (float)taxa_adc_hz() / passo_amostras();
+}
+
+float tarefa1_ultima_saida(void)
+{
+    return convert_to_celsius(ultima_saida_raw);
+}
+
+void tarefa1_configurar_limiares(const tarefa1_limiares_t *novos)
+{
+    limiares = *novos;
+}
+
+bool tarefa1_alerta_ativo(void)
+{
+    return alerta_ativo;
+}
+
+/**
+ * @brief Prepara o acumulador antes da primeira janela.
+ */
+static void preparar_acumulacao(void)
+{
+#if TAREFA1_ACUMULACAO == TAREFA1_ACUM_LUT
+    if (!lut_pronta)
+        gerar_lut_celsius();
+#endif
+}
+
+// Estado da janela em andamento (API assíncrona)
+static dma_channel_config *janela_cfg;
+static int janela_chan;
+static volatile bool janela_ativa = false;
+static uint32_t janela_alvo;   // Amostras da janela
+static uint32_t janela_total;  // Amostras já acumuladas
+static soma_t janela_soma;
+static uint janela_bloco;      // Amostras do bloco em voo
+static float resultado = 0.0f; // Média da última janela concluída
+
+#if TAREFA1_ROUND_ROBIN
+static uint64_t janela_canal_soma[TAREFA1_N_CANAIS]; // Indexado pela posição na sequência
+static uint32_t janela_canal_n[TAREFA1_N_CANAIS];
+static uint janela_fase;                             // Posição da próxima amostra na sequência
+static float medias_canais[TAREFA1_N_CANAIS] = {-1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
+
+/**
+ * @brief Separa um bloco intercalado por canal numa única passada.
+ *
+ * A fase persiste entre blocos: no modo livre as metades não precisam
+ * conter ciclos completos da sequência. A última saída do decimador
+ * passa a ser a média do sensor no bloco.
+ *
+ * @param buffer Amostras intercaladas na ordem de 'rr_ordem'.
+ * @param n Número de amostras.
+ */
+static void acumular_bloco(const uint16_t *buffer, uint n)
+{
+    uint32_t soma[TAREFA1_N_CANAIS] = {0}; // BLOCO_AMOSTRAS × 4095 cabe em 32 bits
+    uint fase = janela_fase;
+
+    for (uint i = 0; i < n; i++)
+    {
+        soma[fase] += buffer[i];
+        if (++fase == rr_n)
+            fase = 0;
+    }
+
+    uint ciclos = n / rr_n;
+    uint resto = n % rr_n;
+    for (uint p = 0; p < rr_n; p++)
+    {
+        // As 'resto' amostras excedentes caem nas posições a partir da fase inicial
+        uint desvio = (p + rr_n - janela_fase) % rr_n;
+        janela_canal_soma[p] += soma[p];
+        janela_canal_n[p] += ciclos + (desvio < resto);
+    }
+
+    uint n_sensor = ciclos + ((rr_posicao_sensor + rr_n - janela_fase) % rr_n < resto);
+    if (n_sensor)
+    {
+        ultima_saida_raw = (float)soma[rr_posicao_sensor] / n_sensor;
+        monitorar_bloco(convert_to_celsius(ultima_saida_raw));
+    }
+    janela_fase = fase;
+}
+#elif !TAREFA1_SNIFFER
+/**
+ * @brief Acumula um bloco na janela, atualiza a saída do decimador e o monitor.
+ */
+static void acumular_bloco(const uint16_t *buffer, uint n)
+{
+    soma_t soma = somar_bloco(buffer, n);
+    janela_soma += soma;
+    registrar_saida_boxcar(buffer + n);
+    monitorar_bloco(media_celsius(soma, n));
+}
+#endif
+
+#if TAREFA1_PING_PONG || TAREFA1_STREAMING
+
+#define METADE_AMOSTRAS (BLOCO_AMOSTRAS / 2)
+
+static bool pingpong_ativo = false;
+
+#if TAREFA1_STREAMING
+
+// Recarga do canal de dados escrita pelo canal de controle a cada meio anel
+static const uint32_t streaming_recarga = METADE_AMOSTRAS;
+
+/**
+ * @brief Interrompe o anel (fim da janela ou troca da configuração).
+ *
+ * O canal de controle é abortado primeiro para não redisparar o de dados.
+ * A interrupção do canal de dados fica mascarada durante o abort, que
+ * ainda pode sinalizar uma conclusão (errata RP2040-E13).
+ */
+static void parar_pingpong_temp(void)
+{
+    if (!pingpong_ativo)
+        return;
+
+    adc_run(false);
+    dma_channel_set_irq0_enabled(DMA_TEMP_CHANNEL, false);
+    dma_channel_abort(DMA_TEMP_CHANNEL_B);
+    dma_channel_abort(DMA_TEMP_CHANNEL);
+    dma_channel_acknowledge_irq0(DMA_TEMP_CHANNEL);
+    dma_channel_set_irq0_enabled(DMA_TEMP_CHANNEL, true);
+    pingpong_ativo = false;
+}
+
+/**
+ * @brief Configura o anel de aquisição contínua.
+ *
+ * O canal de dados escreve meio anel por disparo com wrap de escrita
+ * sobre 'buffer_temp' e encadeia no canal de controle, que grava a
+ * recarga no alias de disparo do contador do canal de dados. O
+ * endereço de escrita continua de onde parou, então cada disparo
+ * preenche automaticamente a metade seguinte do anel.
+ *
+ * @param cfg Configuração base (a mesma do modo por blocos).
+ * @param dma_chan Canal DMA de dados.
+ */
+static void iniciar_pingpong_temp(dma_channel_config *cfg, int dma_chan)
+{
+    dma_channel_config cfg_dados = *cfg;
+    channel_config_set_ring(&cfg_dados, true, __builtin_ctz(ANEL_BYTES));
+    channel_config_set_chain_to(&cfg_dados, DMA_TEMP_CHANNEL_B);
+
+    dma_channel_config cfg_controle = dma_channel_get_default_config(DMA_TEMP_CHANNEL_B);
+    channel_config_set_transfer_data_size(&cfg_controle, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg_controle, false);
+    channel_config_set_write_increment(&cfg_controle, false);
+
+    dma_temp_metades[0] = &buffer_temp[0];
+    dma_temp_metades[1] = &buffer_temp[METADE_AMOSTRAS];
+    dma_temp_metade_seguinte = 0;
+
+    dma_channel_configure(DMA_TEMP_CHANNEL_B, &cfg_controle,
+                          &dma_hw->ch[dma_chan].al1_transfer_count_trig, &streaming_recarga, 1, false);
+    dma_channel_configure(dma_chan, &cfg_dados, buffer_temp, &adc_hw->fifo, METADE_AMOSTRAS, false);
+
+    adc_run(false);
+    adc_fifo_drain();
+    selecionar_entradas_adc();
+    adc_fifo_setup(true, true, 1, false, false);
+    aplicar_taxa_adc();
+
+    dma_channel_start(dma_chan);
+    adc_run(true);
+    pingpong_ativo = true;
+}
+
+#else
+
+/**
+ * @brief Interrompe a aquisição livre (para trocar a configuração).
+ */
+static void parar_pingpong_temp(void)
+{
+    if (!pingpong_ativo)
+        return;
+
+    adc_run(false);
+    dma_channel_abort(DMA_TEMP_CHANNEL);
+    dma_channel_abort(DMA_TEMP_CHANNEL_B);
+    pingpong_ativo = false;
+}
+
+/**
+ * @brief Configura os dois canais encadeados e liga o ADC em modo livre.
+ *
+ * Cada canal escreve em uma metade de 'buffer_temp' e, ao terminar,
+ * dispara o parceiro. O handler 'dma_handler_temp()' rearma o
+ * endereço de escrita do canal que terminou e marca a metade pronta.
+ *
+ * @param cfg Configuração base (a mesma do modo por blocos).
+ * @param dma_chan Canal DMA principal (metade 0).
+ */
+static void iniciar_pingpong_temp(dma_channel_config *cfg, int dma_chan)
+{
+    dma_channel_config cfg_a = *cfg;
+    dma_channel_config cfg_b = *cfg;
+    channel_config_set_chain_to(&cfg_a, DMA_TEMP_CHANNEL_B);
+    channel_config_set_chain_to(&cfg_b, dma_chan);
+
+    dma_temp_metades[0] = &buffer_temp[0];
+    dma_temp_metades[1] = &buffer_temp[METADE_AMOSTRAS];
+
+    dma_channel_configure(dma_chan, &cfg_a, dma_temp_metades[0], &adc_hw->fifo, METADE_AMOSTRAS, false);
+    dma_channel_configure(DMA_TEMP_CHANNEL_B, &cfg_b, dma_temp_metades[1], &adc_hw->fifo, METADE_AMOSTRAS, false);
+    dma_channel_set_irq0_enabled(DMA_TEMP_CHANNEL_B, true);
+
+    adc_run(false);
+    adc_fifo_drain();
+    selecionar_entradas_adc();
+    adc_fifo_setup(true, true, 1, false, false);
+    aplicar_taxa_adc();
+
+    dma_channel_start(dma_chan);
+    adc_run(true);
+    pingpong_ativo = true;
+}
+
+#endif
+
+/**
+ * @brief Abre a janela no modo ping-pong ou streaming.
+ *
+ * As metades concluídas antes do início da janela são descartadas,
+ * para que a média reflita apenas a janela medida. A janela é
+ * arredondada para metades inteiras.
+ */
+static void iniciar_janela(void)
+{
+#if TAREFA1_ROUND_ROBIN
+    parar_pingpong_temp(); // Religa o ADC alinhado ao início da sequência de canais
+#endif
+    if (!pingpong_ativo)
+        iniciar_pingpong_temp(janela_cfg, janela_chan);
+
+    uint32_t irq = save_and_disable_interrupts();
+    dma_temp_metades_prontas = 0;
+    dma_temp_metades_perdidas = 0;
+    restore_interrupts(irq);
+}
+
+/**
+ * @brief Soma as metades que ficaram prontas desde a última chamada.
+ *
+ * Com as duas prontas, a mais antiga (a que não foi concluída por
+ * último) é consumida primeiro: é a próxima a ser sobrescrita.
+ *
+ * @return true quando a janela estiver completa.
+ */
+static bool avancar_janela(void)
+{
+    while (dma_temp_metades_prontas && janela_total < janela_alvo)
+    {
+        uint32_t irq = save_and_disable_interrupts();
+        uint32_t prontas = dma_temp_metades_prontas;
+        uint metade = prontas == 3u ? dma_temp_metade_recente ^ 1u : (prontas & 1u) ? 0 : 1;
+        dma_temp_metades_prontas &= ~(1u << metade);
+        restore_interrupts(irq);
+
+        acumular_bloco(dma_temp_metades[metade], METADE_AMOSTRAS);
+        janela_total += METADE_AMOSTRAS;
+    }
+
+#if TAREFA1_STREAMING
+    if (janela_total >= janela_alvo)
+        parar_pingpong_temp(); // Sem interrupções entre janelas; a próxima religa o anel
+#endif
+    return janela_total >= janela_alvo;
+}
+
+#elif TAREFA1_SNIFFER
+
+/**
+ * @brief Inicia um bloco com a soma das amostras feita pelo sniffer do DMA.
+ *
+ * As transferências passam a 32 bits (a leitura do FIFO traz o código
+ * de 12 bits com os bits superiores zerados), de modo que o sniffer
+ * soma exatamente os códigos brutos. 10.000 × 4095 cabe no acumulador.
+ *
+ * @param cfg Configuração base do canal DMA.
+ * @param dma_chan Canal DMA utilizado.
+ * @param n Número de amostras do bloco.
+ */
+static void iniciar_dma_sniffer(dma_channel_config *cfg, int dma_chan, uint n)
+{
+    dma_channel_config cfg_sniff = *cfg;
+    channel_config_set_transfer_data_size(&cfg_sniff, DMA_SIZE_32);
+    channel_config_set_write_increment(&cfg_sniff, false);
+    channel_config_set_sniff_enable(&cfg_sniff, true);
+
+    adc_run(false);
+    adc_fifo_drain();
+    selecionar_entradas_adc();
+    adc_fifo_setup(true, true, 1, false, false);
+    aplicar_taxa_adc();
+
+    dma_sniffer_enable(dma_chan, DMA_SNIFF_CTRL_CALC_VALUE_SUM, true);
+    dma_sniffer_set_data_accumulator(0);
+    adc_run(true);
+
+    dma_channel_configure(
+        dma_chan,
+        &cfg_sniff,
+        &descarte_sniffer, &adc_hw->fifo,
+        n,
+        true);
+}
+
+/**
+ * @brief Dispara o próximo bloco da janela.
+ */
+static void iniciar_proximo_bloco(void)
+{
+    janela_bloco = tamanho_bloco(janela_alvo - janela_total, BLOCO_AMOSTRAS);
+    dma_temp_done = false;
+    iniciar_dma_sniffer(janela_cfg, janela_chan, janela_bloco);
+}
+
+static void iniciar_janela(void)
+{
+    iniciar_proximo_bloco();
+}
+
+/**
+ * @brief Lê o sniffer quando o bloco em voo termina e dispara o seguinte.
+ *
+ * @return true quando a janela estiver completa.
+ */
+static bool avancar_janela(void)
+{
+    if (!dma_temp_done)
+        return false;
+    adc_run(false); // Desliga o ADC
+
+    uint32_t soma_bloco = dma_sniffer_get_data_accumulator();
+    janela_soma += soma_bloco;
+    ultima_saida_raw = (float)soma_bloco / janela_bloco; // Sem amostras na RAM: boxcar do bloco
+    monitorar_bloco(convert_to_celsius(ultima_saida_raw));
+    janela_total += janela_bloco;
+
+    if (janela_total >= janela_alvo)
+        return true;
+
+    iniciar_proximo_bloco();
+    return false;
+}
+
+#else
+
 /**
  * @brief Inicia uma transferência via DMA de um bloco do sensor de temperatura.
  *
  * @param buffer Buffer de destino.
  * @param cfg Configuração do canal DMA.
  * @param dma_chan Canal DMA utilizado.
+ * @param n Número de amostras do bloco.
  */
-static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_chan)
+static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_chan, uint n)
 {
-    adc_select_input(4); // Canal 4 → sensor interno
-    adc_fifo_drain();
     adc_run(false);
+    adc_fifo_drain();
+    selecionar_entradas_adc();
     adc_fifo_setup(true, true, 1, false, false);
+    aplicar_taxa_adc();
     adc_run(true);
 
     dma_channel_configure(
         dma_chan,
         cfg,
         buffer, &adc_hw->fifo,
-        BLOCO_AMOSTRAS,
+        n,
         true);
 }
 
 /**
- * @brief Executa a Tarefa 1 do executor cíclico: coleta de temperatura por 0,5s.
+ * @brief Dispara o próximo bloco da janela.
+ */
+static void iniciar_proximo_bloco(void)
+{
+    janela_bloco = tamanho_bloco(janela_alvo - janela_total, BLOCO_AMOSTRAS);
+    dma_temp_done = false;
+    iniciar_dma_temp(buffer_temp, janela_cfg, janela_chan, janela_bloco);
+}
+
+static void iniciar_janela(void)
+{
+    iniciar_proximo_bloco();
+}
+
+/**
+ * @brief Soma o bloco em voo quando o DMA termina e dispara o seguinte.
+ *
+ * @return true quando a janela estiver completa.
+ */
+static bool avancar_janela(void)
+{
+    if (!dma_temp_done)
+        return false;
+    adc_run(false); // Desliga o ADC
+
+    acumular_bloco(buffer_temp, janela_bloco);
+    janela_total += janela_bloco;
+
+    if (janela_total >= janela_alvo)
+        return true;
+
+    iniciar_proximo_bloco();
+    return false;
+}
+
+#endif
+
+void tarefa1_start(dma_channel_config *cfg_temp, int dma_chan)
+{
+    preparar_acumulacao();
+
+    janela_cfg = cfg_temp;
+    janela_chan = dma_chan;
+    janela_alvo = amostras_da_janela();
+    janela_total = 0;
+    janela_soma = 0;
+#if TAREFA1_ROUND_ROBIN
+    for (uint p = 0; p < TAREFA1_N_CANAIS; p++)
+    {
+        janela_canal_soma[p] = 0;
+        janela_canal_n[p] = 0;
+    }
+    janela_fase = 0;
+#endif
+    janela_ativa = true;
+
+    iniciar_janela();
+}
+
+bool tarefa1_poll(void)
+{
+    if (!janela_ativa)
+        return true;
+
+    if (!avancar_janela())
+        return false;
+
+#if TAREFA1_ROUND_ROBIN
+    for (uint canal = 0; canal < TAREFA1_N_CANAIS; canal++)
+        medias_canais[canal] = -1.0f;
+    for (uint p = 0; p < rr_n; p++)
+        medias_canais[rr_ordem[p]] = janela_canal_n[p] ? (float)janela_canal_soma[p] / janela_canal_n[p] : -1.0f;
+    resultado = media_celsius(janela_canal_soma[rr_posicao_sensor], janela_canal_n[rr_posicao_sensor]);
+#else
+    resultado = media_celsius(janela_soma, janela_total);
+#endif
+    janela_ativa = false;
+    return true;
+}
+
+float tarefa1_result(void)
+{
+    return resultado;
+}
+
+bool tarefa1_em_andamento(void)
+{
+    return janela_ativa;
+}
+
+#if TAREFA1_ROUND_ROBIN
+float tarefa1_media_canal(uint canal)
+{
+    return canal < TAREFA1_N_CANAIS ? medias_canais[canal] : -1.0f;
+}
+#endif
+
+/**
+ * @brief Executa a Tarefa 1 do executor cíclico: coleta de temperatura durante a janela configurada.
+ *
+ * Versão bloqueante sobre a API assíncrona: dorme com '__wfi()' entre
+ * as interrupções do DMA até a janela terminar.
  *
  * @param cfg_temp Configuração do canal DMA.
  * @param dma_chan Número do canal DMA utilizado.
@@ -88,26 +969,69 @@ static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_
  */
 float tarefa1_obter_media_temp(dma_channel_config *cfg_temp, int dma_chan)
 {
-    float soma = 0.0f;
-    uint32_t total_amostras = 0;
+    tarefa1_start(cfg_temp, dma_chan);
+    while (!tarefa1_poll())
+        __wfi(); // Aguarda a próxima interrupção do DMA
 
-    absolute_time_t inicio = get_absolute_time();
+    return tarefa1_result();
+}
 
-    while (absolute_time_diff_us(inicio, get_absolute_time()) < DURACAO_AMOSTRAGEM_US)
+#if TAREFA1_DUAL_CORE
+
+// Parâmetros repassados ao núcleo 1 (a entrada do núcleo não recebe argumentos)
+static dma_channel_config *core1_cfg;
+static int core1_dma_chan;
+
+/**
+ * @brief Laço de aquisição executado no núcleo 1.
+ *
+ * O handler do DMA é registrado aqui porque o NVIC é próprio de
+ * cada núcleo. Cada média é enviada como palavra de 32 bits pelo
+ * FIFO do SIO; se o FIFO estiver cheio (núcleo 0 sem consumir),
+ * a média é descartada em vez de bloquear a aquisição.
+ */
+static void tarefa1_core1_main(void)
+{
+#if HISTORICO
+    flash_safe_execute_core_init(); // Permite que o núcleo 0 pause este núcleo para gravar a flash
+#endif
+    dma_channel_set_irq0_enabled(core1_dma_chan, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    while (true)
     {
-        dma_temp_done = false;
-        iniciar_dma_temp(buffer_temp, cfg_temp, dma_chan);
-        while (!dma_temp_done)
-            __wfi();    // Aguarda fim do DMA
-        adc_run(false); // Desliga o ADC
+        float media = tarefa1_obter_media_temp(core1_cfg, core1_dma_chan);
+        uint32_t palavra;
+        memcpy(&palavra, &media, sizeof(palavra));
 
-        for (int i = 0; i < BLOCO_AMOSTRAS; i++)
-        {
-            soma += convert_to_celsius(buffer_temp[i]);
-        }
+        if (multicore_fifo_wready())
+            multicore_fifo_push_blocking(palavra);
+    }
+}
+
+void tarefa1_core1_iniciar(dma_channel_config *cfg_temp, int dma_chan)
+{
+    core1_cfg = cfg_temp;
+    core1_dma_chan = dma_chan;
+    multicore_launch_core1(tarefa1_core1_main);
+}
+
+bool tarefa1_core1_obter_media(float *media)
+{
+    bool nova = false;
+    uint32_t palavra;
 
-        total_amostras += BLOCO_AMOSTRAS;
+    // Esvazia o FIFO e fica apenas com a média mais recente
+    while (multicore_fifo_rvalid())
+    {
+        palavra = multicore_fifo_pop_blocking();
+        nova = true;
     }
 
-    return soma / total_amostras;
-}
\ No newline at end of file
+    if (nova)
+        memcpy(media, &palavra, sizeof(*media));
+    return nova;
+}
+
+#endif
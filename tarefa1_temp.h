@@ -1,8 +1,122 @@
 #ifndef TAREFA1_TEMP_H
 #define TAREFA1_TEMP_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "hardware/dma.h"
 
+// Parâmetros de aquisição da Tarefa 1
+typedef struct
+{
+    uint32_t taxa_hz;         // Taxa de saída após a decimação (0 = ADC na taxa máxima)
+    uint32_t janela_us;       // Duração da janela de média
+    uint16_t sobreamostragem; // Amostras do ADC por saída decimada (boxcar), 1 = sem decimação
+    uint8_t canais;           // TAREFA1_ROUND_ROBIN: máscara de entradas do ADC (o sensor é sempre incluído)
+} tarefa1_config_t;
+
+#define TAREFA1_N_CANAIS 5                  // ADC0–3 (GPIO 26–29) e ADC4 (sensor interno)
+#define TAREFA1_CANAL_SENSOR 4
+#define TAREFA1_CANAL_BIT(canal) (1u << (canal))
+
+#define TAREFA1_CONFIG_PADRAO_JANELA_US 500000 // 0,5 segundos em microssegundos
+
+// Comportamento original: ADC livre a 500 kS/s durante 0,5 s
+#define TAREFA1_CONFIG_PADRAO {.taxa_hz = 0, .janela_us = TAREFA1_CONFIG_PADRAO_JANELA_US, .sobreamostragem = 1}
+
+// Exemplo de baixa carga: 1 kS/s com sobreamostragem 16× (ADC a 16 kS/s)
+#define TAREFA1_CONFIG_1KSPS_16X {.taxa_hz = 1000, .janela_us = TAREFA1_CONFIG_PADRAO_JANELA_US, .sobreamostragem = 16}
+
+// Round-robin: sensor interno + termistores externos em ADC0–2, 10 kS/s por canal
+#define TAREFA1_CONFIG_TERMISTORES                                             \
+    {.taxa_hz = 10000, .janela_us = TAREFA1_CONFIG_PADRAO_JANELA_US, .sobreamostragem = 1, \
+     .canais = TAREFA1_CANAL_BIT(0) | TAREFA1_CANAL_BIT(1) | TAREFA1_CANAL_BIT(2) | TAREFA1_CANAL_BIT(TAREFA1_CANAL_SENSOR)}
+
+// Monitor de limiares: avaliado na média de cada bloco do DMA, com histerese
+typedef struct
+{
+    float baixo_c;     // Alerta abaixo deste valor
+    float alto_c;      // Alerta acima deste valor
+    float histerese_c; // Margem para desarmar: volta a [baixo + histerese, alto - histerese]
+} tarefa1_limiares_t;
+
+// Limite inferior do alerta original (média < 1 °C) e sobretemperatura do RP2040
+#define TAREFA1_LIMIARES_PADRAO {.baixo_c = 1.0f, .alto_c = 70.0f, .histerese_c = 0.5f}
+
+/**
+ * @brief Define taxa, janela e sobreamostragem usadas pelas próximas aquisições.
+ *
+ * O ADC só alcança de 733 Hz a 500 kHz: para taxas × sobreamostragem abaixo disso a
+ * sobreamostragem é aumentada (a saída mantém a taxa pedida); acima, ou quando a
+ * sobreamostragem não cabe em meio bloco, a taxa de saída muda.
+ *
+ * @param cfg Nova configuração (copiada)
+ */
+void tarefa1_configurar(const tarefa1_config_t *cfg);
+
+// Taxa de saída (após a decimação) efetivamente aplicada, depois dos ajustes acima
+float tarefa1_taxa_saida_hz(void);
+
+/**
+ * @brief Define os limiares do monitor de alerta (o estado atual é mantido).
+ *
+ * @param limiares Novos limiares (copiados)
+ */
+void tarefa1_configurar_limiares(const tarefa1_limiares_t *limiares);
+
+// Estado do monitor: true entre o cruzamento de um limiar e o retorno à faixa com histerese
+bool tarefa1_alerta_ativo(void);
+
+// Notificação opcional a cada mudança do estado do alerta (contexto de quem processa os blocos)
+extern void (*volatile tarefa1_alerta_notificar)(bool ativo);
+
+// Versão bloqueante: inicia a janela e aguarda o resultado
 float tarefa1_obter_media_temp(dma_channel_config *cfg, int dma_chan);
 
+/**
+ * @brief Inicia uma janela de aquisição e retorna imediatamente.
+ *
+ * @param cfg Configuração do canal DMA
+ * @param dma_chan Canal DMA utilizado
+ */
+void tarefa1_start(dma_channel_config *cfg, int dma_chan);
+
+/**
+ * @brief Avança a janela em andamento sem bloquear.
+ *
+ * Processa os blocos concluídos pelo DMA e dispara o próximo.
+ * Deve ser chamada após cada interrupção do DMA (ver
+ * 'dma_temp_notificar' em irq_handlers.h).
+ *
+ * @return true quando a média da janela está disponível em tarefa1_result()
+ */
+bool tarefa1_poll(void);
+
+// Média da última janela concluída
+float tarefa1_result(void);
+
+// Indica se há uma janela em andamento
+bool tarefa1_em_andamento(void);
+
+// Última saída do estágio de decimação, em °C
+float tarefa1_ultima_saida(void);
+
+#if TAREFA1_ROUND_ROBIN
+/**
+ * @brief Média de uma entrada do ADC na última janela concluída.
+ *
+ * @param canal Entrada do ADC (0 a TAREFA1_N_CANAIS - 1)
+ * @return float Código bruto médio de 12 bits (negativo se o canal não foi amostrado)
+ */
+float tarefa1_media_canal(uint canal);
+#endif
+
+#if TAREFA1_DUAL_CORE
+
+// Lança a aquisição contínua no núcleo 1
+void tarefa1_core1_iniciar(dma_channel_config *cfg, int dma_chan);
+
+// Consome a média mais recente publicada pelo núcleo 1 (false se não houver nova)
+bool tarefa1_core1_obter_media(float *media);
+#endif
+
 #endif
\ No newline at end of file
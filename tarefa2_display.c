@@ -11,6 +11,17 @@
  *
  *      Ambas centralizadas horizontalmente, usando fonte padrão.
  *
+ *      As linhas fixas são desenhadas uma única vez; a cada
+ *      quadro apenas o valor grande e a linha de tendência são
+ *      redesenhados, de forma opaca e sem limpar a tela. As
+ *      primitivas de desenho marcam só os bytes que mudam e
+ *      'ssd1306_swap_buffers()' apresenta o quadro, enviando por
+ *      DMA somente esses trechos; a tarefa retorna logo. O
+ *      desenho é feito no buffer de trás, então o quadro anterior
+ *      pode continuar saindo sem risco de imagem pela metade.
+ *      Os textos vêm do cache de strings pré-rasterizadas.
+ *      Há um único envio por quadro e nenhuma alocação dinâmica.
+ *
  *
  *  Data: 12/05/2025
  * ------------------------------------------------------------
@@ -23,35 +34,55 @@
 #include "tarefa2_display.h"
 #include "tarefa3_tendencia.h"
 
-extern uint8_t ssd[];
 extern struct render_area area;
 
-void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia)
-{
-    ssd1306_clear_display(ssd);
-    render_on_display(ssd, &area); // Garante que a limpeza seja visível
+static bool cabecalho_desenhado = false;
 
+/**
+ * @brief Desenha as linhas fixas uma única vez, a partir de uma tela limpa.
+ */
+static void desenhar_cabecalho(uint8_t *ssd)
+{
     char *linha1 = "Temperatura";
     char *linha2 = "Media";
-    char linha3[30];
 
-    snprintf(linha3, sizeof(linha3), "TEMP: %s", tendencia_para_texto(tendencia));
+    ssd1306_clear_display(ssd); // Apenas RAM: segue no envio do quadro
 
     // Fonte padrão: 6 px por caractere, altura: 8 px
     int x1 = (128 - strlen(linha1) * 6) / 2;
     int x2 = (128 - strlen(linha2) * 6) / 2;
-    int x3 = (128 - strlen(linha3) * 6) / 2;
 
     // Y = linha × altura da fonte (8 px padrão)
-    ssd1306_draw_string(ssd, x1, 0, linha1); // Linha 0 (Y=0)
+    ssd1306_draw_string_cached(ssd, x1, 0, linha1); // Linha 0 (Y=0)
     // Linha 1 = em branco (Y=8)
-    ssd1306_draw_string(ssd, x2, 16, linha2); // Linha 2 (Y=16)
+    ssd1306_draw_string_cached(ssd, x2, 16, linha2); // Linha 2 (Y=16)
     // Linha 3 = em branco (Y=24)
 
+    cabecalho_desenhado = true;
+}
+
+void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia)
+{
+    // Desenho no buffer de trás enquanto o quadro anterior ainda pode estar saindo pelo I2C
+    uint8_t *ssd = ssd1306_back_buffer();
+
+    if (!cabecalho_desenhado)
+        desenhar_cabecalho(ssd);
+
+    // Linha inteira (16 caracteres): o texto anterior é sobrescrito sem limpar a área
+    char linha3[ssd1306_text_cache_max_chars + 1];
+    snprintf(linha3, sizeof(linha3), "TEMP: %-10s", tendencia_para_texto(tendencia));
+
+    // Os desenhos são opacos e só marcam os bytes que mudam: conteúdo igual ao
+    // quadro anterior não gera envio
+
     // Fonte grande começa abaixo: Y=32 px
     mostrar_valor_grande(ssd, temperatura, 32);
 
-    ssd1306_draw_string(ssd, 0, 56, linha3); // Y = 32
+    // Poucas strings possíveis: rasterizadas uma vez e reaproveitadas do cache
+    ssd1306_draw_string_cached(ssd, 0, 56, linha3); // Y = 56
 
-    render_on_display(ssd, &area);
+    // Troca frente/trás: os trechos alterados seguem por DMA e a tarefa retorna logo;
+    // o painel nunca recebe um quadro pela metade
+    ssd1306_swap_buffers();
 }
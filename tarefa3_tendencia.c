@@ -7,19 +7,25 @@
  *      Este módulo implementa a Tarefa 3 do executor cíclico:
  *      a análise de tendência da temperatura.
  *
- *      A função compara a temperatura atual com a anterior
- *      e classifica como:
+ *      Uma reta de mínimos quadrados é ajustada às últimas
+ *      N amostras (temperatura × instante da amostra) e a
+ *      inclinação, em °C/min, é classificada como:
  *          - TENDÊNCIA_SUBINDO
  *          - TENDÊNCIA_CAINDO
  *          - TENDÊNCIA_ESTÁVEL
  *
- *      A tendência é detectada com base em um limiar mínimo
- *      de variação (±0.05°C) e pode ser exibida no terminal
- *      ou no display OLED.
+ *      A classificação tem histerese: entra em SUBINDO/CAINDO
+ *      acima de 'entrada_c_min' e só volta a ESTÁVEL abaixo de
+ *      'saida_c_min', de modo que o ruído do ADC não faz a
+ *      tendência oscilar (nem redesenhar OLED e matriz).
  *
  *  Funcionalidades:
- *      - Armazena a última temperatura registrada
- *      - Retorna enum `tendencia_t` representando o estado
+ *      - Somas da regressão (Σx, Σx², Σy, Σxy) atualizadas em O(1)
+ *        por amostra, em inteiros de 64 bits: x em ms relativo à
+ *        amostra mais antiga, y em m°C. Ao descartar a mais antiga,
+ *        a origem de x é deslocada algebricamente.
+ *      - Retorna `tendencia_info_t` com classificação, inclinação
+ *        e média da janela
  *      - Oferece função auxiliar para converter enum em string
  *
  *  Relacionamento:
@@ -31,34 +37,120 @@
  * ------------------------------------------------------------
  */
 
+#include "pico/stdlib.h"
 #include "tarefa3_tendencia.h"
 
-static float temperatura_anterior = 0.0f;
-static int primeiro_ciclo = 1;
+static tarefa3_config_t config = TAREFA3_CONFIG_PADRAO;
 
-tendencia_t tarefa3_analisa_tendencia(float atual)
+// Janela circular: instante (ms) e temperatura (m°C) de cada amostra
+static uint32_t janela_t_ms[TAREFA3_JANELA_MAX];
+static int32_t janela_y_mc[TAREFA3_JANELA_MAX];
+static uint8_t inicio; // Amostra mais antiga (origem de x)
+static uint8_t n;
+
+static int64_t soma_x, soma_x2, soma_y, soma_xy;
+static tendencia_t estado = TENDENCIA_ESTÁVEL;
+
+void tarefa3_configurar(const tarefa3_config_t *cfg)
 {
-    tendencia_t resultado;
+    config = *cfg;
+    if (config.janela < 2)
+        config.janela = 2;
+    if (config.janela > TAREFA3_JANELA_MAX)
+        config.janela = TAREFA3_JANELA_MAX;
+
+    inicio = 0;
+    n = 0;
+    soma_x = soma_x2 = soma_y = soma_xy = 0;
+    estado = TENDENCIA_ESTÁVEL;
+}
 
-    if (primeiro_ciclo)
+/**
+ * @brief Remove a amostra mais antiga (x = 0) e move a origem para a seguinte.
+ */
+static void descartar_mais_antiga(void)
+{
+    uint32_t t0 = janela_t_ms[inicio];
+
+    soma_y -= janela_y_mc[inicio]; // x = 0: não contribui para Σx, Σx², Σxy
+    inicio = (inicio + 1) % TAREFA3_JANELA_MAX;
+    n--;
+    if (n == 0)
     {
-        resultado = TENDENCIA_ESTÁVEL;
-        primeiro_ciclo = 0;
+        soma_x = soma_x2 = soma_y = soma_xy = 0;
+        return;
     }
-    else
+
+    // x' = x - d para todas as amostras restantes
+    int64_t d = (int64_t)(janela_t_ms[inicio] - t0);
+    soma_x2 += -2 * d * soma_x + (int64_t)n * d * d;
+    soma_xy -= d * soma_y;
+    soma_x -= (int64_t)n * d;
+}
+
+/**
+ * @brief Aplica a histerese à inclinação.
+ */
+static tendencia_t classificar(float inclinacao)
+{
+    switch (estado)
     {
-        float delta = atual - temperatura_anterior;
-
-        if (delta > 0.01f)
-            resultado = TENDENCIA_SUBINDO;
-        else if (delta < -0.01f)
-            resultado = TENDENCIA_CAINDO;
-        else
-            resultado = TENDENCIA_ESTÁVEL;
+    case TENDENCIA_SUBINDO:
+        if (inclinacao < -config.entrada_c_min)
+            return TENDENCIA_CAINDO;
+        return inclinacao < config.saida_c_min ? TENDENCIA_ESTÁVEL : TENDENCIA_SUBINDO;
+    case TENDENCIA_CAINDO:
+        if (inclinacao > config.entrada_c_min)
+            return TENDENCIA_SUBINDO;
+        return inclinacao > -config.saida_c_min ? TENDENCIA_ESTÁVEL : TENDENCIA_CAINDO;
+    default:
+        if (inclinacao > config.entrada_c_min)
+            return TENDENCIA_SUBINDO;
+        if (inclinacao < -config.entrada_c_min)
+            return TENDENCIA_CAINDO;
+        return TENDENCIA_ESTÁVEL;
     }
+}
+
+tendencia_info_t tarefa3_estimar_tendencia(float atual)
+{
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    int32_t y = (int32_t)(atual * 1000.0f);
+
+    if (n == config.janela)
+        descartar_mais_antiga();
+
+    uint8_t pos = (inicio + n) % TAREFA3_JANELA_MAX;
+    int64_t x = n ? (int64_t)(agora_ms - janela_t_ms[inicio]) : 0;
+    janela_t_ms[pos] = agora_ms;
+    janela_y_mc[pos] = y;
+    n++;
+    soma_x += x;
+    soma_x2 += x * x;
+    soma_y += y;
+    soma_xy += x * y;
 
-    temperatura_anterior = atual;
-    return resultado;
+    // inclinação = (nΣxy − ΣxΣy) / (nΣx² − (Σx)²), em m°C/ms = °C/s
+    float inclinacao = 0.0f;
+    int64_t den = (int64_t)n * soma_x2 - soma_x * soma_x;
+    if (n >= 2 && den > 0)
+        inclinacao = (float)((int64_t)n * soma_xy - soma_x * soma_y) / (float)den * 60.0f;
+
+    if (n >= TAREFA3_AMOSTRAS_MIN)
+        estado = classificar(inclinacao);
+
+    tendencia_info_t info = {
+        .tendencia = estado,
+        .inclinacao_c_min = inclinacao,
+        .media_janela = (float)soma_y / (1000.0f * n),
+        .amostras = n,
+    };
+    return info;
+}
+
+tendencia_t tarefa3_analisa_tendencia(float atual)
+{
+    return tarefa3_estimar_tendencia(atual).tendencia;
 }
 
 const char *tendencia_para_texto(tendencia_t t)
@@ -72,4 +164,4 @@ const char *tendencia_para_texto(tendencia_t t)
     default:
         return "ESTAVEL";
     }
-}
\ No newline at end of file
+}
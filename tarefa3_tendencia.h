@@ -9,7 +9,9 @@
  *
  *      Fornece:
  *        - Enumeração `tendencia_t` com os três estados possíveis
- *        - Função para determinar a tendência com base na temperatura atual
+ *        - Estimador por regressão linear numa janela deslizante,
+ *          com histerese, e seu resultado expandido
+ *          (`tendencia_info_t`, com a inclinação em °C/min)
  *        - Função para converter a tendência em texto
  *
  *
@@ -20,6 +22,8 @@
 #ifndef TAREFA3_TENDENCIA_H
 #define TAREFA3_TENDENCIA_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -33,8 +37,52 @@ extern "C"
         TENDENCIA_CAINDO
     } tendencia_t;
 
+    // Resultado expandido do estimador
+    typedef struct
+    {
+        tendencia_t tendencia;  // Classificação com histerese
+        float inclinacao_c_min; // Inclinação da reta ajustada à janela (°C/min)
+        float media_janela;     // Média das temperaturas da janela (°C)
+        uint8_t amostras;       // Amostras atualmente na janela
+    } tendencia_info_t;
+
+    // Parâmetros do estimador
+    typedef struct
+    {
+        uint8_t janela;      // Amostras na regressão (2 a TAREFA3_JANELA_MAX)
+        float entrada_c_min; // |inclinação| acima da qual SUBINDO/CAINDO é declarado
+        float saida_c_min;   // |inclinação| abaixo da qual volta a ESTÁVEL (< entrada)
+    } tarefa3_config_t;
+
+#define TAREFA3_JANELA_MAX 32
+
+// Amostras mínimas para classificar (antes disso a tendência é ESTÁVEL)
+#define TAREFA3_AMOSTRAS_MIN 3
+
+// ~10 s de histórico com a Tarefa 3 a cada 1,25 s; histerese de 0,3 / 0,1 °C/min
+#define TAREFA3_CONFIG_PADRAO {.janela = 8, .entrada_c_min = 0.3f, .saida_c_min = 0.1f}
+
+    /**
+     * @brief Define janela e histerese e reinicia o estimador.
+     *
+     * @param cfg Nova configuração (copiada)
+     */
+    void tarefa3_configurar(const tarefa3_config_t *cfg);
+
+    /**
+     * @brief Acrescenta uma amostra à janela e reavalia a tendência.
+     *
+     * Custo O(1) por amostra: as somas da regressão são mantidas de forma
+     * incremental, em inteiros (m°C e ms), sem deriva numérica. O instante
+     * da amostra é o da chamada.
+     *
+     * @param atual Temperatura atual (ºC)
+     * @return Classificação, inclinação e média da janela
+     */
+    tendencia_info_t tarefa3_estimar_tendencia(float atual);
+
     /**
-     * @brief Analisa a tendência com base na temperatura atual e anterior.
+     * @brief Analisa a tendência com base na temperatura atual (só a classificação).
      *
      * @param atual Temperatura atual (ºC)
      * @return tendência identificada
@@ -53,4 +101,4 @@ extern "C"
 }
 #endif
 
-#endif // TAREFA3_TENDENCIA_H
\ No newline at end of file
+#endif // TAREFA3_TENDENCIA_H
@@ -28,7 +28,14 @@
 
 #include "neopixel_driver.h"
 #include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h" // CAMADA_TENDENCIA
 #include "testes_cores.h" // contém COR_AZUL, COR_VERDE, COR_VERMELHO
+#if NEOPIXEL_ANIMACAO
+#include "efeitos.h"
+
+// Intervalo entre quadros da transição em espiral (25 quadros ≈ 1 s)
+#define TAREFA4_ESPIRAL_MS 40
+#endif
 
 /**
  * @brief Define a cor de todos os LEDs da matriz de acordo com a tendência.
@@ -37,18 +44,55 @@
  */
 void tarefa4_matriz_cor_por_tendencia(tendencia_t t)
 {
+#if NEOPIXEL_ANIMACAO
+    // A mudança de tendência dispara uma espiral na nova cor, avançada pela tarefa de animação;
+    // o último quadro deixa a matriz inteira na cor, como o npSetAll() do modo estático
+    static bool primeira = true;
+    static tendencia_t anterior;
+
+    if (!primeira && t == anterior)
+        return;
+    primeira = false;
+    anterior = t;
+
+    switch (t)
+    {
+    case TENDENCIA_CAINDO:
+        npAnimTocar(quadroEspiral, COR_AZUL, TAREFA4_ESPIRAL_MS);
+        break;
+    case TENDENCIA_ESTÁVEL:
+        npAnimTocar(quadroEspiral, COR_VERDE, TAREFA4_ESPIRAL_MS);
+        break;
+    case TENDENCIA_SUBINDO:
+        npAnimTocar(quadroEspiral, COR_VERMELHO, TAREFA4_ESPIRAL_MS);
+        break;
+    }
+    return;
+#endif
+
+#if NEOPIXEL_CAMADAS
+#define PINTAR_MATRIZ(cor) npLayerSetAll(CAMADA_TENDENCIA, cor)
+#else
+#define PINTAR_MATRIZ(cor) npSetAll(cor)
+#endif
     switch (t)
     {
     case TENDENCIA_CAINDO:
-        npSetAll(COR_AZUL); // Azul
+        PINTAR_MATRIZ(COR_AZUL); // Azul
         break;
     case TENDENCIA_ESTÁVEL:
-        npSetAll(COR_VERDE); // Verde
+        PINTAR_MATRIZ(COR_VERDE); // Verde
         break;
     case TENDENCIA_SUBINDO:
-        npSetAll(COR_VERMELHO); // Vermelho
+        PINTAR_MATRIZ(COR_VERMELHO); // Vermelho
         break;
     }
+#undef PINTAR_MATRIZ
 
-    npWrite(); // Atualiza fisicamente a matriz
+    // Atualiza fisicamente a matriz (só transmite se o quadro mudou)
+#if NEOPIXEL_CAMADAS
+    npComposeWrite();
+#else
+    npWrite();
+#endif
 }
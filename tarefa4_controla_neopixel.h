@@ -25,6 +25,10 @@
 
 #include "tarefa3_tendencia.h" // para o tipo tendencia_t
 
+// Camadas do compositor NeoPixel (NEOPIXEL_CAMADAS): o alerta fica sobre a tendência
+#define CAMADA_TENDENCIA 0
+#define CAMADA_ALERTA 1
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -33,6 +37,11 @@ extern "C"
     /**
      * @brief Define a cor da matriz NeoPixel conforme a tendência térmica.
      *
+     * Com NEOPIXEL_CAMADAS a cor vai para a camada CAMADA_TENDENCIA e o
+     * quadro é composto com o alerta da Tarefa 5. Com NEOPIXEL_ANIMACAO,
+     * cada mudança de tendência inicia uma espiral na nova cor, executada
+     * quadro a quadro pela tarefa de animação.
+     *
      * @param t Valor da tendência detectada: SUBINDO, ESTÁVEL ou CAINDO
      */
     void tarefa4_matriz_cor_por_tendencia(tendencia_t t);
@@ -0,0 +1,535 @@
+/**
+ * @file tarefas.c
+ * @brief Task set of the cyclic scheduler: the static task table and the task functions.
+ *
+ * The table and the tasks are kept out of main.c so that the host simulation benchmark
+ * (host/bench.c) runs exactly the firmware's task set, in the same build configuration,
+ * over the simulated peripherals.
+ *
+ * Global Variables:
+ * - Task table (task_table) consumed by the scheduler.
+ * - Timing variables for profiling (ini_tarefaX, fim_tarefaX).
+ * - Shared data through topics (TOPICO_TEMPERATURA, TOPICO_TENDENCIA, TOPICO_ALERTA).
+ *
+ * Functions:
+ * - show_duration_tasks_execution(): Prints timing and temperature/trend info.
+ * - task_0_staged_startup(): Brings up the display, NeoPixels and USB after sampling has started.
+ * - task_1_read_temperature(): Reads and averages temperature.
+ * - task_2_show_oled(): Updates OLED display.
+ * - task_3_thermal_trend(): Analyzes temperature trend.
+ * - task_4_update_neopixel_matrix(): Updates NeoPixel matrix based on trend.
+ * - task_5_alert_neopixel(): Controls NeoPixel alert based on the task 1 threshold monitor.
+ * - tarefas_conectar(): Subscribes the consumer tasks to their topics.
+ *
+ * Dependencies:
+ * - Pico SDK (stdlib, timer, watchdog)
+ * - External modules: setup.h, scheduler.h, profiler.h, topicos.h, tarefa1_temp.h, tarefa2_display.h,
+ *   tarefa3_tendencia.h, tarefa4_controla_neopixel.h, neopixel_driver.h, testes_cores.h
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+
+#include "tarefas.h"
+#include "setup.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "topicos.h"
+#if TELEMETRIA
+#include "telemetria.h"
+#endif
+#if HISTORICO
+#include "historico.h"
+#endif
+#include "tarefa1_temp.h"
+#include "irq_handlers.h"
+#include "tarefa2_display.h"
+#include "ssd1306.h"
+#include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h"
+#include "neopixel_driver.h"
+#if NEOPIXEL_ANIMACAO
+#include "animacao.h"
+#endif
+#include "testes_cores.h"
+
+// Written and read only by the tasks themselves on core 0, which never preempt each other
+static absolute_time_t ini_tarefa1, fim_tarefa1, ini_tarefa2, fim_tarefa2, ini_tarefa3, fim_tarefa3, ini_tarefa4, fim_tarefa4;
+
+#if TAREFA1_ASSINCRONA && TAREFA1_DUAL_CORE
+#error "TAREFA1_ASSINCRONA and TAREFA1_DUAL_CORE are alternative ways to unblock task 1"
+#endif
+
+// Startup milestones recorded by the profiler (time since reset); one object per name,
+// since profiler_marcar() tells the milestones apart by pointer
+const char MARCO_PRIMEIRA_AMOSTRA[] = "1a amostra";
+static const char MARCO_PRIMEIRA_MEDIA[] = "1a media";
+static const char MARCO_PRIMEIRO_QUADRO[] = "1o quadro";
+
+// Reports between two histogram dumps
+#define PROFILER_HIST_EVERY 10
+
+#if NEOPIXEL_ANIMACAO && CYCLIC_EXECUTIVE
+#error "NEOPIXEL_ANIMACAO needs a 20 ms task; the cyclic executive frame is sized for task 1"
+#endif
+
+/**
+ * @brief Static task table consumed by the scheduler.
+ *
+ * Only the producer at the head of the data flow is periodic. Tasks 3, 2, 4 and 5 are
+ * sporadic subscribers: task 1 publishes the temperature, which releases task 3 (trend) and
+ * task 2 (OLED); task 3 publishes the trend, which releases task 2 again (coalesced with the
+ * pending release) and task 4 (matrix). Sporadic ties are broken by priority, so each cycle
+ * still runs T1 → T3 → T2 → T4 right after the acquisition window, and an unchanged value
+ * does not wake task 2. Task 3 subscribes to every temperature publication, repeats
+ * included: the trend regression and the flash history expect one evenly spaced sample
+ * per cycle. Task 4 likewise takes every trend publication, since it closes the cycle with
+ * the timing report; an unchanged trend costs it no matrix transfer. Budgets are the expected worst-case execution times in microseconds.
+ *
+ * Startup is staged: main() only configures the ADC and DMA before starting the scheduler,
+ * and the sporadic startup task brings up the OLED, the NeoPixels and USB one non-blocking
+ * step per release. No step waits on the bus: task 1 samples on its first release while the
+ * OLED init commands are still going out over I2C by DMA, and the profiler report opens with
+ * the time to the first sample, the first average and the first frame on the panel.
+ *
+ * With TAREFA1_ASSINCRONA, task 1 is split into a periodic task that only opens the
+ * acquisition window and a sporadic task released by the DMA interrupt that processes
+ * each finished block, so the other tasks run while the window is in flight.
+ *
+ * Task 5 subscribes to the alert topic, published by task 1's threshold monitor as soon as a
+ * DMA block crosses a limit (or returns inside the hysteresis band). Sporadic tasks precede
+ * the periodic ones, so the alert is shown right after the block that triggered it is
+ * processed: one block time with TAREFA1_ASSINCRONA, or as soon as task 1 returns otherwise.
+ * With TAREFA1_DUAL_CORE blocks are processed on core 1, so task 1 republishes the monitor
+ * state with each average it picks up instead.
+ *
+ * The NeoPixel tasks are flagged SCHEDULER_TASK_SHEDDABLE: when another task overruns or
+ * misses a deadline the scheduler drops them until the system is healthy again. The alert
+ * entry is not: it must show while the system is degraded. Task 4's budget includes printing
+ * the timing report.
+ *
+ * With TELEMETRIA, the tasks log binary records instead of calling printf and a background
+ * task drains them over USB, at most TELEM_BYTES_POR_DRENO bytes per release. It is flagged
+ * SCHEDULER_TASK_BACKGROUND: the blocking task 1 holds the CPU for a whole window, so the
+ * 50 ms drain misses releases by design, and those misses must neither starve the watchdog
+ * nor stop the drain while degraded. The history task is flagged the same way.
+ *
+ * With NEOPIXEL_ANIMACAO, task 6 advances the current NeoPixel animation by at most one
+ * frame per release, so effects run alongside acquisition and display. Its budget holds
+ * one frame render plus the DMA start.
+ *
+ * With HISTORICO, the history task performs at most one flash operation per release; its
+ * budget covers a sector erase, which happens once every 15 programmed pages.
+ */
+const scheduler_task_t task_table[TASK_COUNT] = {
+        //                   name            period  offset  budget   prio  entry                           flags
+        [TASK_BOOT] =       {"T0 partida",   0,      0,      20000,   0,    task_0_staged_startup},
+#if TAREFA1_ASSINCRONA
+        [TASK_T1] =         {"T1 inicio",    1000,   0,      500,     0,    task_1_start_temperature},
+        [TASK_T1_COLLECT] = {"T1 coleta",    0,      0,      20000,   0,    task_1_collect_temperature},
+#else
+        [TASK_T1] =         {"T1 temp",      1000,   0,      520000,  0,    task_1_read_temperature},
+#endif
+        [TASK_T5] =         {"T5 alerta",    0,      0,      2000,    1,    task_5_alert_neopixel},
+        [TASK_T3] =         {"T3 tendencia", 0,      0,      1000,    2,    task_3_thermal_trend},
+        [TASK_T2] =         {"T2 OLED",      0,      0,      60000,   3,    task_2_show_oled},
+        [TASK_T4] =         {"T4 matriz",    0,      0,      20000,   4,    task_4_update_neopixel_matrix,  SCHEDULER_TASK_SHEDDABLE},
+#if NEOPIXEL_ANIMACAO
+        [TASK_T6] =         {"T6 animacao",  20,     0,      300,     5,    npAnimTarefa,                   SCHEDULER_TASK_SHEDDABLE},
+#endif
+#if TELEMETRIA
+        [TASK_TELEM] =      {"telemetria",   50,     5,      3000,    6,    telem_drenar,                   SCHEDULER_TASK_BACKGROUND},
+#endif
+#if HISTORICO
+        [TASK_HIST] =       {"historico",    500,    700,    100000,  7,    historico_tarefa,               SCHEDULER_TASK_BACKGROUND},
+#endif
+};
+/**
+ * @brief Displays the execution duration of four tasks along with temperature information and trend.
+ *
+ * This function calculates the execution time (in microseconds) for four tasks using their respective
+ * start and end timestamps. It then prints the average temperature, the execution time of each task
+ * (converted to seconds with microsecond precision), and the current trend as a formatted message.
+ *
+ * Assumes the following external/global variables and functions are available:
+ * - ini_tarefa1, fim_tarefa1, ini_tarefa2, fim_tarefa2, ini_tarefa3, fim_tarefa3, ini_tarefa4, fim_tarefa4:
+ *   Timestamps marking the start and end of each task.
+ * - absolute_time_diff_us(): Function to compute the time difference in microseconds.
+ * - TOPICO_TEMPERATURA, TOPICO_TENDENCIA: The average temperature and the current trend.
+ * - tendencia_para_texto(): Function to convert the trend indicator to a human-readable string.
+ *
+ * It then prints the profiler table (min/mean/p99/max of every task, including task 5),
+ * with the full histograms every PROFILER_HIST_EVERY reports, followed by the scheduler's
+ * supervision counters (deadline misses, overruns, shed releases and release jitter).
+ *
+ * With TELEMETRIA the same data is queued as binary records (raw float bits and integer
+ * microseconds), with no formatting on the target.
+ */
+void show_duration_tasks_execution()
+{
+        static uint reports = 0;
+        float media;
+        tendencia_info_t info;
+        topico_ler(TOPICO_TEMPERATURA, &media, sizeof(media));
+        topico_ler(TOPICO_TENDENCIA, &info, sizeof(info));
+        tendencia_t t = info.tendencia;
+
+        int64_t tempo1_us = absolute_time_diff_us(ini_tarefa1, fim_tarefa1);
+        int64_t tempo2_us = absolute_time_diff_us(ini_tarefa2, fim_tarefa2);
+        int64_t tempo3_us = absolute_time_diff_us(ini_tarefa3, fim_tarefa3);
+        int64_t tempo4_us = absolute_time_diff_us(ini_tarefa4, fim_tarefa4);
+
+#if TELEMETRIA
+        telem_registrar(TELEM_TEMPERATURA, telem_float(media), t, 0);
+        telem_registrar(TELEM_DURACOES, tempo1_us, tempo2_us, tempo3_us);
+        telem_registrar(TELEM_DURACAO_T4, tempo4_us, 0, 0);
+        for (uint i = 0; profiler_stats(i); i++)
+                telem_registrar(TELEM_PERFIL, i, profiler_stats(i)->max_us, profiler_percentil_hist_us(i, 99));
+#if !CYCLIC_EXECUTIVE
+        for (uint i = 0; i < count_of(task_table); i++)
+                telem_registrar(TELEM_SUPERVISAO, i, scheduler_stats(i)->deadline_misses, scheduler_stats(i)->overruns);
+#endif
+        (void)reports;
+        return;
+#endif
+
+        printf("Temperatura: %.2f °C | T1: %.6fs | T2: %.6fs | T3: %.6fs | T4: %.6fs | Tendência: %s\n",
+               media,
+               tempo1_us / 1e6,
+               tempo2_us / 1e6,
+               tempo3_us / 1e6,
+               tempo4_us / 1e6,
+               tendencia_para_texto(t));
+#if TAREFA1_ROUND_ROBIN
+        printf("ADC0: %.1f | ADC1: %.1f | ADC2: %.1f (códigos médios)\n",
+               tarefa1_media_canal(0),
+               tarefa1_media_canal(1),
+               tarefa1_media_canal(2));
+#endif
+        profiler_relatorio(++reports % PROFILER_HIST_EVERY == 0);
+#if !CYCLIC_EXECUTIVE
+        printf("Modo %s | ciclos saudáveis: %lu | ocioso: %lu%%\n",
+               scheduler_degraded() ? "DEGRADADO" : "normal",
+               (unsigned long)scheduler_healthy_cycles(),
+               (unsigned long)(scheduler_idle_us() * 100 / time_us_64()));
+        for (uint i = 0; i < count_of(task_table); i++)
+        {
+                const scheduler_task_stats_t *s = scheduler_stats(i);
+                if (s->deadline_misses || s->overruns || s->shed)
+                        printf("  %-14s perdas: %lu | overruns: %lu | descartes: %lu | jitter máx: %lu us\n",
+                               task_table[i].name,
+                               (unsigned long)s->deadline_misses,
+                               (unsigned long)s->overruns,
+                               (unsigned long)s->shed,
+                               (unsigned long)s->jitter_max_us);
+        }
+#endif
+}
+
+/**
+ * @brief Publishes a window average; the first one marks the time to the first measurement.
+ */
+static void publish_temperature(float media)
+{
+        profiler_marcar(MARCO_PRIMEIRA_MEDIA);
+        topico_publicar(TOPICO_TEMPERATURA, &media, sizeof(media));
+}
+
+/**
+ * @brief OLED flush hook armed by task 2's first frame: marks the time to the first frame.
+ *
+ * Runs in the flush DMA interrupt, once the frame's last bytes are in the I2C FIFO.
+ */
+static void mark_first_frame(void)
+{
+        profiler_marcar(MARCO_PRIMEIRO_QUADRO);
+        ssd1306_flush_done_cb = NULL;
+}
+
+/**
+ * @brief Staged startup task: one non-blocking initialization step per release.
+ *
+ * Released once by main() after `setup_aquisicao()`; each step re-releases the task for the
+ * next one, and being sporadic it runs ahead of task 1 without holding the CPU:
+ *  - the OLED: I2C, flush DMA and the init commands queued on it (frames follow them);
+ *  - the NeoPixel PIO program and DMA channel;
+ *  - USB stdio, after which the reboot cause and the history status can be printed.
+ */
+void task_0_staged_startup()
+{
+        static uint step = 0;
+
+        switch (step++)
+        {
+        case 0:
+                setup_display();
+                break;
+        case 1:
+                setup_neopixel();
+                break;
+        default:
+                setup_stdio();
+                if (watchdog_caused_reboot())
+                        printf("Reiniciado pelo watchdog: ciclos sem saúde por mais de %d ms\n", SCHEDULER_WATCHDOG_MS);
+#if HISTORICO
+                if (!historico_init())
+                        printf("Histórico desativado: região reservada sobreposta ao binário\n");
+#endif
+                return; // Startup complete
+        }
+
+        scheduler_release(TASK_BOOT);
+}
+
+/**
+ * @brief Reads the temperature, calculates the average, and records timing.
+ *
+ * This function marks the start time, obtains the average temperature reading
+ * using the configuration and DMA channel, and then marks the end time.
+ * With TAREFA1_DUAL_CORE the acquisition runs on core 1 and this task only
+ * picks up the latest average sent by core 1, publishing nothing if none arrived, and
+ * republishes the threshold monitor state.
+ *
+ * Globals used:
+ *  - ini_tarefa1: Stores the start timestamp of the task.
+ *  - fim_tarefa1: Stores the end timestamp of the task.
+ *  - TOPICO_TEMPERATURA: Receives the calculated average temperature.
+ *  - cfg_temp: Configuration structure for temperature reading.
+ *  - DMA_TEMP_CHANNEL: DMA channel used for temperature sensor.
+ *
+ * Functions called:
+ *  - get_absolute_time(): Returns the current absolute time.
+ *  - tarefa1_obter_media_temp(): Calculates the average temperature.
+ */
+void task_1_read_temperature()
+{
+        ini_tarefa1 = get_absolute_time();
+#if TAREFA1_DUAL_CORE
+        float media;
+        bool nova = tarefa1_core1_obter_media(&media);
+        bool alerta = tarefa1_alerta_ativo(); // Monitor on core 1: republished from core 0
+        topico_publicar(TOPICO_ALERTA, &alerta, sizeof(alerta));
+#else
+        profiler_marcar(MARCO_PRIMEIRA_AMOSTRA);
+        float media = tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL);
+        bool nova = true;
+#endif
+        fim_tarefa1 = get_absolute_time();
+        if (nova)
+                publish_temperature(media);
+}
+
+/**
+ * @brief Opens a non-blocking temperature acquisition window (TAREFA1_ASSINCRONA).
+ *
+ * If the previous window is still in flight the release is skipped, so a slow
+ * acquisition never stacks windows. `ini_tarefa1` marks the window start.
+ */
+void task_1_start_temperature()
+{
+        if (tarefa1_em_andamento())
+                return;
+
+        ini_tarefa1 = get_absolute_time();
+        profiler_marcar(MARCO_PRIMEIRA_AMOSTRA);
+        tarefa1_start(&cfg_temp, DMA_TEMP_CHANNEL);
+}
+
+/**
+ * @brief Processes the DMA blocks finished since the last call (TAREFA1_ASSINCRONA).
+ *
+ * Released by the DMA interrupt through `dma_temp_notificar`. When the window completes,
+ * the average is published and `fim_tarefa1` marks the end, so T1 reports the window latency.
+ */
+void task_1_collect_temperature()
+{
+        if (tarefa1_em_andamento() && tarefa1_poll())
+        {
+                fim_tarefa1 = get_absolute_time();
+                publish_temperature(tarefa1_result());
+        }
+}
+
+#if !TAREFA1_DUAL_CORE
+/**
+ * @brief Threshold monitor hook: publishes the alert state, releasing task 5.
+ *
+ * Runs wherever task 1 processes its blocks (task 1 itself or the collection task).
+ */
+static void publish_alert(bool ativo)
+{
+        topico_publicar(TOPICO_ALERTA, &ativo, sizeof(ativo));
+}
+#endif
+
+#if TAREFA1_ASSINCRONA
+/**
+ * @brief DMA interrupt hook: releases the sporadic collection task.
+ */
+static void release_task_1_collect(void)
+{
+        scheduler_release(TASK_T1_COLLECT);
+}
+#endif
+
+/**
+ * @brief Executes the thermal trend analysis task.
+ *
+ * This function records the start and end times of the thermal trend analysis task.
+ * It feeds the latest published average to the sliding-window estimator
+ * `tarefa3_estimar_tendencia()` and publishes the hysteresis-filtered trend and the
+ * fitted slope. With HISTORICO the average is also queued for the flash history.
+ *
+ * Global variables used:
+ * - ini_tarefa3: Stores the start time of the task.
+ * - fim_tarefa3: Stores the end time of the task.
+ * - TOPICO_TEMPERATURA: The average value used for trend analysis (subscribed).
+ * - TOPICO_TENDENCIA: Receives the result of the trend analysis.
+ */
+void task_3_thermal_trend()
+{
+        float media;
+        topico_ler(TOPICO_TEMPERATURA, &media, sizeof(media));
+
+        ini_tarefa3 = get_absolute_time();
+        tendencia_info_t info = tarefa3_estimar_tendencia(media);
+        fim_tarefa3 = get_absolute_time();
+        topico_publicar(TOPICO_TENDENCIA, &info, sizeof(info));
+#if HISTORICO
+        historico_registrar(media);
+#endif
+#if TELEMETRIA
+        telem_registrar(TELEM_TENDENCIA, info.tendencia, telem_float(info.inclinacao_c_min), info.amostras);
+#else
+        printf("Tendência: %s (%.2f °C/min, %u amostras)\n", tendencia_para_texto(info.tendencia), info.inclinacao_c_min, info.amostras);
+#endif
+}
+
+/**
+ * @brief Executes the OLED display task.
+ *
+ * This function records the start time, calls the function to display data on the OLED
+ * (a snapshot of the temperature and trend topics, both subscribed), and then records the
+ * end time.
+ *
+ * It is assumed that 'ini_tarefa2' and 'fim_tarefa2' are used for timing measurements.
+ */
+void task_2_show_oled()
+{
+        float media;
+        tendencia_info_t info;
+        topico_ler(TOPICO_TEMPERATURA, &media, sizeof(media));
+        topico_ler(TOPICO_TENDENCIA, &info, sizeof(info));
+        tendencia_t t = info.tendencia;
+
+        static bool first_frame = true;
+        if (first_frame)
+        {
+                first_frame = false;
+                ssd1306_flush_done_cb = mark_first_frame;
+        }
+
+        ini_tarefa2 = get_absolute_time();
+        tarefa2_exibir_oled(media, t);
+#if TELEMETRIA
+        telem_registrar(TELEM_OLED, telem_float(media), t, 0);
+#else
+        printf("Exibindo no OLED: %.2f °C | Tendência: %s\n", media, tendencia_para_texto(t));
+#endif
+        fim_tarefa2 = get_absolute_time();
+}
+
+/**
+ * @brief Updates the NeoPixel matrix based on the current trend.
+ *
+ * This function records the start and end times of the update operation for profiling or timing purposes.
+ * It calls `tarefa4_matriz_cor_por_tendencia(t)` to update the matrix colors according to the trend,
+ * then prints the task durations, closing the reporting cycle.
+ *
+ * The trend comes from TOPICO_TENDENCIA, subscribed to every publication (repeats included),
+ * so the report closes each cycle; an unchanged trend leaves the matrix frame untouched.
+ */
+void task_4_update_neopixel_matrix()
+{
+        tendencia_info_t info;
+        topico_ler(TOPICO_TENDENCIA, &info, sizeof(info));
+        tendencia_t t = info.tendencia;
+
+        ini_tarefa4 = get_absolute_time();
+        tarefa4_matriz_cor_por_tendencia(t);
+#if TELEMETRIA
+        telem_registrar(TELEM_MATRIZ, t, 0, 0);
+#else
+        printf("Atualizando matriz NeoPixel com a tendência: %s\n", tendencia_para_texto(t));
+#endif
+        fim_tarefa4 = get_absolute_time();
+        show_duration_tasks_execution();
+}
+
+/**
+ * @brief Controls the NeoPixel alert based on task 1's threshold monitor (TOPICO_ALERTA).
+ *
+ * While the monitor reports an alert (a block average outside TAREFA1_LIMIARES_PADRAO, with
+ * hysteresis), all NeoPixels are set to the color defined by COR_BRANCA and updated.
+ * Otherwise, all NeoPixels are cleared and updated.
+ *
+ * With NEOPIXEL_CAMADAS the alert is drawn on its own layer above the trend colour instead,
+ * so clearing the alert reveals task 4's frame rather than blanking the matrix.
+ * Unchanged frames are not retransmitted either way.
+ *
+ * Assumes that npSetAll, npWrite, npClear, and COR_BRANCA are defined elsewhere in the codebase.
+ */
+void task_5_alert_neopixel()
+{
+        bool alerta;
+        topico_ler(TOPICO_ALERTA, &alerta, sizeof(alerta));
+#if NEOPIXEL_CAMADAS
+        if (alerta)
+                npLayerSetAll(CAMADA_ALERTA, COR_BRANCA);
+        else
+                npLayerClear(CAMADA_ALERTA);
+        npComposeWrite();
+#else
+        if (alerta)
+        {
+                npSetAll(COR_BRANCA);
+                npWrite();
+        }
+        else
+        {
+                npClear();
+                npWrite();
+        }
+#endif
+#if TELEMETRIA
+        telem_registrar(TELEM_ALERTA, alerta, 0, 0);
+#else
+        printf("Task 5! \n");
+#endif
+}
+
+/**
+ * @brief Connects the tasks to their events (see tarefas.h).
+ *
+ * The subscriptions encode the data flow described with the task table; task 3 takes every
+ * temperature publication and task 4 every trend publication, the other consumers only the
+ * changes.
+ */
+void tarefas_conectar(void)
+{
+#if !TAREFA1_DUAL_CORE
+        tarefa1_alerta_notificar = publish_alert; // Block-rate alert updates
+#endif
+#if !CYCLIC_EXECUTIVE
+        assert(!(task_table[TASK_T5].flags & SCHEDULER_TASK_SHEDDABLE)); // The alert must survive degraded mode
+        topico_assinar_todas(TOPICO_TEMPERATURA, TASK_T3); // Tendência e histórico: uma amostra por ciclo
+        topico_assinar(TOPICO_TEMPERATURA, TASK_T2);
+        topico_assinar(TOPICO_TENDENCIA, TASK_T2);
+        topico_assinar_todas(TOPICO_TENDENCIA, TASK_T4); // Relatório de tempos: fecha todo ciclo
+        topico_assinar(TOPICO_ALERTA, TASK_T5);
+#if TAREFA1_ASSINCRONA
+        dma_temp_notificar = release_task_1_collect;
+#endif
+#endif
+}
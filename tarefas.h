@@ -0,0 +1,66 @@
+/**
+ * @file tarefas.h
+ * @brief Task set of the firmware: the static task table and the task entry points.
+ *
+ * Shared by main.c and the host simulation benchmark (host/bench.c), so that both run the
+ * same table in the same build configuration.
+ */
+
+#ifndef TAREFAS_H
+#define TAREFAS_H
+
+#include "scheduler.h"
+
+/**
+ * @brief Indices of the task table, so that events can release tasks by name.
+ */
+enum
+{
+        TASK_BOOT,
+        TASK_T1,
+#if TAREFA1_ASSINCRONA
+        TASK_T1_COLLECT,
+#endif
+        TASK_T5,
+        TASK_T3,
+        TASK_T2,
+        TASK_T4,
+#if NEOPIXEL_ANIMACAO
+        TASK_T6,
+#endif
+#if TELEMETRIA
+        TASK_TELEM,
+#endif
+#if HISTORICO
+        TASK_HIST,
+#endif
+        TASK_COUNT
+};
+
+/**
+ * @brief Static task table consumed by the scheduler (see tarefas.c).
+ */
+extern const scheduler_task_t task_table[TASK_COUNT];
+
+// Startup milestone of the first sample; marked by main() when core 1 does the sampling
+extern const char MARCO_PRIMEIRA_AMOSTRA[];
+
+void task_0_staged_startup();
+void task_3_thermal_trend();
+void task_5_alert_neopixel();
+void task_4_update_neopixel_matrix();
+void task_2_show_oled();
+void task_1_read_temperature();
+void task_1_start_temperature();
+void task_1_collect_temperature();
+void show_duration_tasks_execution();
+
+/**
+ * @brief Connects the tasks to their events: task 1's alert hook, and with the scheduler
+ * the topic subscriptions and the DMA collection hook.
+ *
+ * Called once before the scheduler starts (after `scheduler_init()`, when there is one).
+ */
+void tarefas_conectar(void);
+
+#endif // TAREFAS_H
@@ -0,0 +1,57 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: telemetria.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Drenagem do anel de telemetria pela USB CDC.
+ *
+ *      O checksum é calculado aqui, fora das tarefas
+ *      produtoras. Os bytes vão direto para o stdio, sem
+ *      tradução de fim de linha, para não corromper o binário.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "telemetria.h"
+#include "pico/stdio_usb.h"
+
+_Static_assert((TELEM_N_REGISTROS & (TELEM_N_REGISTROS - 1)) == 0, "TELEM_N_REGISTROS deve ser potência de 2");
+
+telem_registro_t telem_anel[TELEM_N_REGISTROS];
+volatile uint32_t telem_cabeca = 0;
+volatile uint32_t telem_cauda = 0;
+uint32_t telem_descartes = 0;
+
+void telem_drenar(void)
+{
+    uint32_t cauda = telem_cauda;
+    uint orcamento = TELEM_BYTES_POR_DRENO;
+
+    if (!stdio_usb_connected())
+    {
+        telem_cauda = telem_cabeca; // Sem host: descarta em vez de acumular
+        return;
+    }
+
+    while (cauda != telem_cabeca && orcamento >= sizeof(telem_registro_t))
+    {
+        telem_registro_t r;
+        memcpy(&r, &telem_anel[cauda % TELEM_N_REGISTROS], sizeof(r));
+
+        const uint8_t *bytes = (const uint8_t *)&r;
+        uint8_t chk = 0;
+        for (uint i = 0; i < sizeof(r); i++)
+            chk ^= bytes[i]; // 'chk' ainda é 0
+        r.chk = chk;
+
+        for (uint i = 0; i < sizeof(r); i++)
+            putchar_raw(bytes[i]);
+
+        cauda++;
+        orcamento -= sizeof(r);
+    }
+    telem_cauda = cauda;
+}
@@ -0,0 +1,122 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: telemetria.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Canal de telemetria binário, alternativo ao printf
+ *      nas tarefas (opção CMake TELEMETRIA=ON).
+ *
+ *      Cada evento é um registro fixo de 20 bytes (ids,
+ *      instante, valores brutos e durações) copiado para um
+ *      anel sem travas; a tarefa produtora paga só a cópia.
+ *      Uma tarefa de fundo de baixa prioridade drena o anel
+ *      pela USB, limitada a TELEM_BYTES_POR_DRENO por
+ *      liberação. Com o anel cheio os registros são
+ *      descartados (nunca bloqueia) e contados em
+ *      'telem_descartes'; o número de sequência permite ao
+ *      host detectar as lacunas.
+ *
+ *      Formato do registro (little-endian):
+ *          [0]     TELEM_SYNC (0xA5)
+ *          [1]     id (telem_id_t)
+ *          [2]     sequência (8 bits, circular)
+ *          [3]     XOR dos bytes 0..19 exceto este
+ *          [4..7]  instante em us (time_us_32)
+ *          [8..19] três valores de 32 bits (significado por id)
+ *
+ *      'tools/telemetria_decoder.py' decodifica o fluxo no host.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <stdint.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#define TELEM_SYNC 0xA5
+
+// Registros no anel (potência de 2)
+#ifndef TELEM_N_REGISTROS
+#define TELEM_N_REGISTROS 64
+#endif
+
+// Limite de bytes enviados por liberação da tarefa de drenagem
+#ifndef TELEM_BYTES_POR_DRENO
+#define TELEM_BYTES_POR_DRENO 256
+#endif
+
+// Identificadores de evento; os valores a, b, c de cada um são:
+typedef enum
+{
+    TELEM_TEMPERATURA = 1, // a = média (bits do float, °C), b = tendência
+    TELEM_TENDENCIA = 2,   // a = tendência, b = inclinação (bits do float, °C/min), c = amostras
+    TELEM_OLED = 3,        // a = média exibida (bits do float), b = tendência
+    TELEM_MATRIZ = 4,      // a = tendência exibida
+    TELEM_ALERTA = 5,      // a = 1 se o alerta está aceso
+    TELEM_DURACOES = 6,    // a = T1 us, b = T2 us, c = T3 us (última execução)
+    TELEM_DURACAO_T4 = 7,  // a = T4 us
+    TELEM_PERFIL = 8,      // a = índice da tarefa, b = máximo us, c = p99 (histograma) us
+    TELEM_SUPERVISAO = 9,  // a = índice da tarefa, b = perdas de deadline, c = overruns
+} telem_id_t;
+
+typedef struct __attribute__((packed))
+{
+    uint8_t sync;
+    uint8_t id;
+    uint8_t seq;
+    uint8_t chk; // Preenchido na drenagem
+    uint32_t t_us;
+    uint32_t a, b, c;
+} telem_registro_t;
+
+_Static_assert(sizeof(telem_registro_t) == 20, "registro de telemetria deve ter 20 bytes");
+
+// Estado do anel: 'telem_cabeca' só é escrito pelo produtor e 'telem_cauda' só pelo consumidor
+extern telem_registro_t telem_anel[TELEM_N_REGISTROS];
+extern volatile uint32_t telem_cabeca;
+extern volatile uint32_t telem_cauda;
+extern uint32_t telem_descartes;
+
+/**
+ * @brief Enfileira um evento. Um só produtor (laço principal); não bloqueia.
+ */
+static inline void telem_registrar(telem_id_t id, uint32_t a, uint32_t b, uint32_t c)
+{
+    static uint8_t seq = 0;
+    uint32_t cabeca = telem_cabeca;
+
+    if (cabeca - telem_cauda >= TELEM_N_REGISTROS)
+    {
+        telem_descartes++;
+        seq++; // A lacuna aparece na sequência
+        return;
+    }
+
+    telem_registro_t r = {TELEM_SYNC, (uint8_t)id, seq++, 0, time_us_32(), a, b, c};
+    memcpy(&telem_anel[cabeca % TELEM_N_REGISTROS], &r, sizeof(r));
+    __asm volatile("" ::: "memory"); // Registro completo antes de publicar a cabeça
+    telem_cabeca = cabeca + 1;
+}
+
+/**
+ * @brief Bits de um float para transporte sem formatação.
+ */
+static inline uint32_t telem_float(float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Tarefa de fundo: envia até TELEM_BYTES_POR_DRENO bytes do anel pela USB.
+ */
+void telem_drenar(void);
+
+#endif // TELEMETRIA_H
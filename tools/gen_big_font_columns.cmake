@@ -0,0 +1,67 @@
+# Generates the big font in the SSD1306 page-major byte layout.
+#
+# Usage: cmake -DINPUT=font_big_logo_data.c -DOUTPUT=font_big_columns.h -P gen_big_font_columns.cmake
+#
+# INPUT holds 16x32 glyphs as "const uint8_t <name>[64]" arrays, two bytes per
+# pixel row, MSB = leftmost pixel. For every glyph the script emits
+# "<name>_cols[64]": 4 pages of 16 column bytes, bit b of page p = pixel row
+# 8p + b, which is exactly what the display RAM expects. The blitter can then
+# copy whole bytes instead of setting 512 individual pixels.
+#
+# BIG_FONT_INK_PAGES is the number of leading pages that hold any lit pixel
+# across all glyphs; the pages below it are blank and need not be drawn.
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT DEFINED INPUT OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "gen_big_font_columns: INPUT and OUTPUT must be defined")
+endif()
+
+file(READ "${INPUT}" source)
+string(REGEX MATCHALL "const uint8_t [A-Za-z_][A-Za-z0-9_]*\\[64\\] = {[^}]*}" glyphs "${source}")
+if(NOT glyphs)
+    message(FATAL_ERROR "${INPUT}: no 64-byte glyph arrays found")
+endif()
+
+get_filename_component(input_name "${INPUT}" NAME)
+set(out "// Gerado por tools/gen_big_font_columns.cmake a partir de ${input_name}. Não editar.\n\n")
+string(APPEND out "#ifndef FONT_BIG_COLUMNS_H\n#define FONT_BIG_COLUMNS_H\n\n#include <stdint.h>\n\n")
+string(APPEND out "// Glifos de 16x32 em 4 páginas de 16 colunas (bit b da página p = linha 8p + b)\n")
+set(ink_pages 0)
+
+foreach(glyph IN LISTS glyphs)
+    string(REGEX MATCH "const uint8_t ([A-Za-z_][A-Za-z0-9_]*)\\[64\\] = {([^}]*)}" _ "${glyph}")
+    set(name ${CMAKE_MATCH_1})
+    string(REGEX MATCHALL "0x[0-9A-Fa-f]+" values "${CMAKE_MATCH_2}")
+    list(LENGTH values count)
+    if(NOT count EQUAL 64)
+        message(FATAL_ERROR "${INPUT}: glyph ${name} has ${count} bytes (expected 64)")
+    endif()
+
+    string(APPEND out "static const uint8_t ${name}_cols[64] = {\n")
+    foreach(page RANGE 3)
+        set(line "   ")
+        foreach(col RANGE 15)
+            set(column 0)
+            foreach(bit RANGE 7)
+                math(EXPR index "(${page} * 8 + ${bit}) * 2 + ${col} / 8")
+                list(GET values ${index} row)
+                math(EXPR column "${column} | (((${row} >> (7 - ${col} % 8)) & 1) << ${bit})")
+            endforeach()
+            if(NOT column EQUAL 0 AND page GREATER_EQUAL ink_pages)
+                math(EXPR ink_pages "${page} + 1")
+            endif()
+            math(EXPR column "${column}" OUTPUT_FORMAT HEXADECIMAL)
+            string(APPEND line " ${column},")
+        endforeach()
+        string(APPEND out "${line} // página ${page}\n")
+    endforeach()
+    string(APPEND out "};\n\n")
+endforeach()
+
+string(APPEND out "// Páginas iniciais com pixels acesos em algum glifo (as demais são vazias)\n")
+string(APPEND out "#define BIG_FONT_INK_PAGES ${ink_pages}\n\n")
+string(APPEND out "#endif // FONT_BIG_COLUMNS_H\n")
+file(WRITE "${OUTPUT}" "${out}")
+list(LENGTH glyphs n_glyphs)
+message(STATUS "Big font: ${n_glyphs} glyphs transposed to page-major columns")
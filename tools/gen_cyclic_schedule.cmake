@@ -0,0 +1,246 @@
+# Generates the static frame table of the cyclic executive.
+#
+# Usage: cmake -DINPUT=cyclic_tasks.txt -DOUTPUT=cyclic_schedule.h -P gen_cyclic_schedule.cmake
+#
+# Each line of INPUT declares "NAME PERIOD_MS WCET_MS". The script computes
+# the hyperperiod (major frame), picks the largest minor frame f that
+#   - divides the hyperperiod,
+#   - is not shorter than the largest WCET (jobs are not preempted),
+#   - satisfies 2f - gcd(f, p) <= p for every period p (deadline = period),
+# and assigns every job of the hyperperiod to a frame inside its release
+# window (EDF order, first fit). Sets that cannot be packed abort the build,
+# as do tables of more than MAX_FRAMES minor frames (default 256).
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT DEFINED INPUT OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "gen_cyclic_schedule: INPUT and OUTPUT must be defined")
+endif()
+if(NOT DEFINED MAX_FRAMES)
+    set(MAX_FRAMES 256)
+endif()
+
+function(_gcd a b out)
+    while(NOT b EQUAL 0)
+        math(EXPR r "${a} % ${b}")
+        set(a ${b})
+        set(b ${r})
+    endwhile()
+    set(${out} ${a} PARENT_SCOPE)
+endfunction()
+
+# Left-pads a number with zeros so that list(SORT) orders numerically
+function(_pad value out)
+    string(LENGTH "${value}" len)
+    set(padded "${value}")
+    while(len LESS 10)
+        set(padded "0${padded}")
+        math(EXPR len "${len} + 1")
+    endwhile()
+    set(${out} "${padded}" PARENT_SCOPE)
+endfunction()
+
+# --- Parse the task set ---------------------------------------------------
+file(STRINGS "${INPUT}" lines ENCODING UTF-8)
+set(names)
+set(n 0)
+foreach(line IN LISTS lines)
+    string(STRIP "${line}" line)
+    if(line STREQUAL "" OR line MATCHES "^#")
+        continue()
+    endif()
+    if(NOT line MATCHES "^([A-Za-z_][A-Za-z0-9_]*)[ \t]+([0-9]+)[ \t]+([0-9]+)$")
+        message(FATAL_ERROR "${INPUT}: invalid line '${line}' (expected NAME PERIOD_MS WCET_MS)")
+    endif()
+    set(name ${CMAKE_MATCH_1})
+    if(name IN_LIST names)
+        message(FATAL_ERROR "${INPUT}: task ${name} declared twice")
+    endif()
+    if(CMAKE_MATCH_2 EQUAL 0 OR CMAKE_MATCH_3 EQUAL 0)
+        message(FATAL_ERROR "${INPUT}: task ${name} needs non-zero period and WCET")
+    endif()
+    if(CMAKE_MATCH_3 GREATER CMAKE_MATCH_2)
+        message(FATAL_ERROR "${INPUT}: task ${name} has WCET ${CMAKE_MATCH_3} ms > period ${CMAKE_MATCH_2} ms")
+    endif()
+    list(APPEND names ${name})
+    set(period_${n} ${CMAKE_MATCH_2})
+    set(wcet_${n} ${CMAKE_MATCH_3})
+    math(EXPR n "${n} + 1")
+endforeach()
+
+if(n EQUAL 0)
+    message(FATAL_ERROR "${INPUT}: no tasks declared")
+endif()
+math(EXPR last "${n} - 1")
+
+# --- Hyperperiod, utilization and bounds -----------------------------------
+set(hyper 1)
+set(max_wcet 0)
+set(min_period 0)
+set(load 0)
+foreach(i RANGE ${last})
+    _gcd(${hyper} ${period_${i}} g)
+    math(EXPR hyper "${hyper} / ${g} * ${period_${i}}")
+    if(wcet_${i} GREATER max_wcet)
+        set(max_wcet ${wcet_${i}})
+    endif()
+    if(min_period EQUAL 0 OR period_${i} LESS min_period)
+        set(min_period ${period_${i}})
+    endif()
+endforeach()
+foreach(i RANGE ${last})
+    math(EXPR load "${load} + ${wcet_${i}} * (${hyper} / ${period_${i}})")
+endforeach()
+if(load GREATER hyper)
+    message(FATAL_ERROR "Cyclic schedule infeasible: utilization ${load}/${hyper} ms exceeds 100%")
+endif()
+
+# --- Try minor frames from the largest candidate down ----------------------
+set(found FALSE)
+set(f ${min_period})
+while(f GREATER_EQUAL max_wcet AND NOT found)
+    math(EXPR rem "${hyper} % ${f}")
+    set(ok FALSE)
+    if(rem EQUAL 0)
+        set(ok TRUE)
+        foreach(i RANGE ${last})
+            _gcd(${f} ${period_${i}} g)
+            math(EXPR lhs "2 * ${f} - ${g}")
+            if(lhs GREATER period_${i})
+                set(ok FALSE)
+                break()
+            endif()
+        endforeach()
+    endif()
+
+    if(ok)
+        math(EXPR n_frames "${hyper} / ${f}")
+        if(n_frames GREATER MAX_FRAMES)
+            # Smaller frames only add frames: the search cannot succeed below this point
+            message(FATAL_ERROR "Cyclic schedule too large: minor frame ${f} ms needs ${n_frames} frames "
+                                "for the hyperperiod of ${hyper} ms (MAX_FRAMES ${MAX_FRAMES}); "
+                                "use harmonic periods in ${INPUT}")
+        endif()
+        math(EXPR last_frame "${n_frames} - 1")
+        foreach(j RANGE ${last_frame})
+            set(used_${j} 0)
+            set(frame_${j})
+        endforeach()
+
+        # Jobs sorted by absolute deadline, ties by declaration order
+        set(jobs)
+        foreach(i RANGE ${last})
+            math(EXPR n_jobs "${hyper} / ${period_${i}} - 1")
+            foreach(k RANGE ${n_jobs})
+                math(EXPR release "${k} * ${period_${i}}")
+                math(EXPR deadline "${release} + ${period_${i}}")
+                _pad(${deadline} d)
+                _pad(${i} t)
+                list(APPEND jobs "${d}:${t}:${release}")
+            endforeach()
+        endforeach()
+        list(SORT jobs)
+
+        foreach(job IN LISTS jobs)
+            string(REPLACE ":" ";" fields "${job}")
+            list(GET fields 0 deadline)
+            list(GET fields 1 i)
+            list(GET fields 2 release)
+            math(EXPR deadline "${deadline}")
+            math(EXPR i "${i}")
+            math(EXPR first "(${release} + ${f} - 1) / ${f}")
+            math(EXPR limit "${deadline} / ${f} - 1")
+            set(placed FALSE)
+            if(first LESS_EQUAL limit)
+                foreach(j RANGE ${first} ${limit})
+                    math(EXPR total "${used_${j}} + ${wcet_${i}}")
+                    if(total LESS_EQUAL f)
+                        set(used_${j} ${total})
+                        _pad(${i} t)
+                        list(APPEND frame_${j} ${t})
+                        set(placed TRUE)
+                        break()
+                    endif()
+                endforeach()
+            endif()
+            if(NOT placed)
+                set(ok FALSE)
+                break()
+            endif()
+        endforeach()
+    endif()
+
+    if(ok)
+        set(found TRUE)
+    else()
+        math(EXPR f "${f} - 1")
+    endif()
+endwhile()
+
+if(NOT found)
+    message(FATAL_ERROR "Cyclic schedule infeasible: no minor frame between ${max_wcet} and "
+                        "${min_period} ms can hold the task set of ${INPUT} (hyperperiod ${hyper} ms)")
+endif()
+
+# --- Emit the header --------------------------------------------------------
+set(max_jobs 1)
+foreach(j RANGE ${last_frame})
+    list(SORT frame_${j}) # Padded indices: declaration order
+    list(LENGTH frame_${j} count)
+    if(count GREATER max_jobs)
+        set(max_jobs ${count})
+    endif()
+endforeach()
+
+get_filename_component(input_name "${INPUT}" NAME)
+set(out "// Gerado por tools/gen_cyclic_schedule.cmake a partir de ${input_name}. Não editar.\n\n")
+string(APPEND out "#ifndef CYCLIC_SCHEDULE_H\n#define CYCLIC_SCHEDULE_H\n\n#include <stdint.h>\n\n")
+string(APPEND out "#define CYCLIC_MINOR_FRAME_MS ${f}\n")
+string(APPEND out "#define CYCLIC_MAJOR_FRAME_MS ${hyper}\n")
+string(APPEND out "#define CYCLIC_N_FRAMES ${n_frames}\n")
+string(APPEND out "#define CYCLIC_N_TASKS ${n}\n")
+string(APPEND out "#define CYCLIC_MAX_JOBS_PER_FRAME ${max_jobs}\n\n")
+
+string(APPEND out "enum\n{\n")
+foreach(i RANGE ${last})
+    list(GET names ${i} name)
+    string(APPEND out "    CYCLIC_TASK_${name}, // período ${period_${i}} ms, WCET ${wcet_${i}} ms\n")
+endforeach()
+string(APPEND out "};\n\n")
+
+string(APPEND out "typedef struct\n{\n    uint8_t count;\n    uint8_t tasks[CYCLIC_MAX_JOBS_PER_FRAME];\n} cyclic_frame_t;\n\n")
+
+string(APPEND out "static const uint32_t cyclic_task_wcet_ms[CYCLIC_N_TASKS] = {")
+foreach(i RANGE ${last})
+    string(APPEND out " ${wcet_${i}},")
+endforeach()
+string(APPEND out " };\n\n")
+
+string(APPEND out "static const char *const cyclic_task_names[CYCLIC_N_TASKS] = {")
+foreach(i RANGE ${last})
+    list(GET names ${i} name)
+    string(APPEND out " \"${name}\",")
+endforeach()
+string(APPEND out " };\n\n")
+
+string(APPEND out "static const cyclic_frame_t cyclic_frames[CYCLIC_N_FRAMES] = {\n")
+foreach(j RANGE ${last_frame})
+    list(LENGTH frame_${j} count)
+    set(entries)
+    foreach(i IN LISTS frame_${j})
+        math(EXPR i "${i}")
+        list(GET names ${i} name)
+        list(APPEND entries "CYCLIC_TASK_${name}")
+    endforeach()
+    string(JOIN ", " entries ${entries})
+    string(APPEND out "    {${count}, {${entries}}}, // carga ${used_${j}}/${f} ms\n")
+endforeach()
+string(APPEND out "};\n\n")
+
+foreach(j RANGE ${last_frame})
+    string(APPEND out "_Static_assert(${used_${j}} <= CYCLIC_MINOR_FRAME_MS, \"quadro ${j} excede o quadro menor\");\n")
+endforeach()
+string(APPEND out "\n#endif // CYCLIC_SCHEDULE_H\n")
+
+file(WRITE "${OUTPUT}" "${out}")
+message(STATUS "Cyclic schedule: minor frame ${f} ms, major frame ${hyper} ms, ${n_frames} frames")
@@ -0,0 +1,66 @@
+# Generates the NeoPixel matrix (x, y) -> strip index table.
+#
+# Usage: cmake -DINPUT=neopixel_driver.h -DOUTPUT=led_index_table.h -P gen_led_index_table.cmake
+#
+# The matrix size is read from the NUM_COLUNAS / NUM_LINHAS defines in INPUT,
+# so resizing the matrix only needs the header change. The strip is wired as a
+# serpentine starting at the bottom-right corner: y = 0 is the top row, and on
+# even physical rows (counted from the bottom) x runs right to left. Entries
+# are 8-bit up to 256 LEDs (e.g. a 16x16 panel) and 16-bit beyond that.
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT DEFINED INPUT OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "gen_led_index_table: INPUT and OUTPUT must be defined")
+endif()
+
+file(READ "${INPUT}" source)
+foreach(dim NUM_COLUNAS NUM_LINHAS)
+    string(REGEX MATCH "#define[ \t]+${dim}[ \t]+([0-9]+)" _ "${source}")
+    if(NOT CMAKE_MATCH_1)
+        message(FATAL_ERROR "${INPUT}: ${dim} not found")
+    endif()
+    set(${dim} ${CMAKE_MATCH_1})
+endforeach()
+
+math(EXPR n_leds "${NUM_COLUNAS} * ${NUM_LINHAS}")
+if(n_leds GREATER 65536)
+    message(FATAL_ERROR "${INPUT}: ${n_leds} LEDs do not fit the 16-bit index table")
+elseif(n_leds GREATER 256)
+    set(index_type uint16_t)
+else()
+    set(index_type uint8_t)
+endif()
+
+get_filename_component(input_name "${INPUT}" NAME)
+set(out "// Gerado por tools/gen_led_index_table.cmake a partir de ${input_name}. Não editar.\n\n")
+string(APPEND out "#ifndef LED_INDEX_TABLE_H\n#define LED_INDEX_TABLE_H\n\n#include <stdint.h>\n\n")
+string(APPEND out "#define LED_INDEX_TABLE_COLUNAS ${NUM_COLUNAS}\n#define LED_INDEX_TABLE_LINHAS ${NUM_LINHAS}\n")
+string(APPEND out "#define LED_INDEX_TABLE_TYPE ${index_type}\n\n")
+string(APPEND out "// Índice na fita do LED (x, y): led_index_table[y][x]\n")
+string(APPEND out "static const ${index_type} led_index_table[${NUM_LINHAS}][${NUM_COLUNAS}] = {\n")
+
+math(EXPR last_row "${NUM_LINHAS} - 1")
+math(EXPR last_col "${NUM_COLUNAS} - 1")
+foreach(y RANGE ${last_row})
+    math(EXPR fisica "${last_row} - ${y}")
+    math(EXPR base "${fisica} * ${NUM_COLUNAS}")
+    math(EXPR par "${fisica} % 2")
+    set(line "    {")
+    foreach(x RANGE ${last_col})
+        if(par EQUAL 0)
+            math(EXPR index "${base} + ${last_col} - ${x}")
+        else()
+            math(EXPR index "${base} + ${x}")
+        endif()
+        string(APPEND line "${index}")
+        if(x LESS last_col)
+            string(APPEND line ", ")
+        endif()
+    endforeach()
+    string(APPEND out "${line}}, // y = ${y}\n")
+endforeach()
+
+string(APPEND out "};\n\n#endif // LED_INDEX_TABLE_H\n")
+file(WRITE "${OUTPUT}" "${out}")
+message(STATUS "NeoPixel index table: ${NUM_COLUNAS}x${NUM_LINHAS}")
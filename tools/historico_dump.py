@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Dumps and decodes the flash temperature history (HISTORICO=ON) over the Pico's USB CDC port.
+
+Usage: historico_dump.py /dev/ttyACM0 [imagem.bin]   (needs pyserial; optionally saves the raw region)
+       historico_dump.py imagem.bin                  (decodes a previously saved region)
+
+Sending 'H' makes the firmware flush its pending page and stream the whole region in
+chunks: 'H' 'C', offset (u32), length (u16), data, xor of the data; a zero-length chunk
+ends the dump. Output is CSV: sample index, temperature in degrees C.
+"""
+
+import struct
+import sys
+
+MAGIC = 0x54534948
+SECTOR = 4096
+PAGE = 256
+CHUNK = struct.Struct("<2sIH")
+
+
+def read_exact(stream, n):
+    data = bytearray()
+    while len(data) < n:
+        part = stream.read(n - len(data))
+        if not part:
+            raise EOFError("dump interrompido")
+        data += part
+    return bytes(data)
+
+
+def dump(port):
+    import serial  # type: ignore
+    stream = serial.Serial(port, timeout=5)
+    stream.reset_input_buffer()
+    stream.write(b"H")
+    image = bytearray()
+    window = b""
+    while True:
+        # Resynchronises on 'HC', skipping telemetry and text printed meanwhile
+        window = (window + read_exact(stream, 1))[-2:]
+        if window != b"HC":
+            continue
+        window = b""
+        _, offset, length = CHUNK.unpack(b"HC" + read_exact(stream, CHUNK.size - 2))
+        data = read_exact(stream, length)
+        chk = read_exact(stream, 1)[0]
+        x = 0
+        for byte in data:
+            x ^= byte
+        if x != chk:
+            sys.exit(f"checksum inválido no bloco em 0x{offset:x}")
+        if length == 0:
+            return bytes(image)
+        if offset != len(image):
+            sys.exit(f"bloco fora de ordem: 0x{offset:x}, esperado 0x{len(image):x}")
+        image += data
+
+
+def varints(data):
+    value = shift = 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            yield (value >> 1) ^ -(value & 1)  # zigzag
+            value = shift = 0
+
+
+def samples(image):
+    sectors = []
+    for base in range(0, len(image) - SECTOR + 1, SECTOR):
+        magic, seq = struct.unpack_from("<II", image, base)
+        if magic == MAGIC:
+            sectors.append((seq, base))
+    for _, base in sorted(sectors):
+        for page in range(base + PAGE, base + SECTOR, PAGE):
+            used = image[page]
+            if used == 0xFF:
+                break
+            index, value = struct.unpack_from("<Ih", image, page + 1)
+            yield index, value
+            for delta in varints(image[page + 7:page + used]):
+                index += 1
+                value += delta
+                yield index, value
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(__doc__)
+    if sys.argv[1].endswith(".bin"):
+        with open(sys.argv[1], "rb") as f:
+            image = f.read()
+    else:
+        image = dump(sys.argv[1])
+        if len(sys.argv) == 3:
+            with open(sys.argv[2], "wb") as f:
+                f.write(image)
+    print("indice,temperatura_c")
+    for index, value in samples(image):
+        print(f"{index},{value / 100:.2f}")
+
+
+if __name__ == "__main__":
+    main()
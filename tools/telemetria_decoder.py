@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Decodes the binary telemetry stream (TELEMETRIA=ON) read from the Pico's USB CDC port.
+
+Usage: telemetria_decoder.py /dev/ttyACM0   (needs pyserial)
+       telemetria_decoder.py captura.bin    (raw capture file)
+
+Records are 20 bytes: sync 0xA5, id, seq, xor checksum, t_us, a, b, c (little-endian).
+Text printed by the firmware (boot messages) is skipped while resynchronising.
+"""
+
+import struct
+import sys
+
+SYNC = 0xA5
+RECORD = struct.Struct("<BBBBIIII")
+TENDENCIAS = {0: "estavel", 1: "subindo", 2: "caindo"}
+
+
+def as_float(bits):
+    return struct.unpack("<f", struct.pack("<I", bits))[0]
+
+
+def tendencia(v):
+    return TENDENCIAS.get(v, str(v))
+
+
+FORMATTERS = {
+    1: lambda a, b, c: f"temperatura {as_float(a):.2f} C tendencia {tendencia(b)}",
+    2: lambda a, b, c: f"tendencia {tendencia(a)} {as_float(b):+.2f} C/min ({c} amostras)",
+    3: lambda a, b, c: f"oled {as_float(a):.2f} C {tendencia(b)}",
+    4: lambda a, b, c: f"matriz {tendencia(a)}",
+    5: lambda a, b, c: f"alerta {'aceso' if a else 'apagado'}",
+    6: lambda a, b, c: f"duracoes T1 {a} us T2 {b} us T3 {c} us",
+    7: lambda a, b, c: f"duracao T4 {a} us",
+    8: lambda a, b, c: f"perfil tarefa {a} max {b} us p99 <= {c} us",
+    9: lambda a, b, c: f"supervisao tarefa {a} perdas {b} overruns {c}",
+}
+
+
+def records(stream, live):
+    """Yields records; a live port waits out read timeouts, a file ends at EOF."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if live:
+                continue
+            return
+        buf += chunk
+        while len(buf) >= RECORD.size:
+            if buf[0] != SYNC:
+                del buf[0]
+                continue
+            chk = 0
+            for i, byte in enumerate(buf[:RECORD.size]):
+                if i != 3:
+                    chk ^= byte
+            if chk != buf[3]:
+                del buf[0]
+                continue
+            yield RECORD.unpack(bytes(buf[:RECORD.size]))
+            del buf[:RECORD.size]
+
+
+def open_source(path):
+    """Returns (stream, live): a serial port when pyserial is available, else a file."""
+    try:
+        import serial  # type: ignore
+        if not path.endswith(".bin"):
+            return serial.Serial(path, timeout=1), True
+    except ImportError:
+        pass
+    return open(path, "rb"), False
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    last_seq = None
+    stream, live = open_source(sys.argv[1])
+    for _, ident, seq, _, t_us, a, b, c in records(stream, live):
+        if last_seq is not None and seq != (last_seq + 1) & 0xFF:
+            print(f"# {(seq - last_seq - 1) & 0xFF} registro(s) perdido(s)")
+        last_seq = seq
+        fmt = FORMATTERS.get(ident, lambda a, b, c: f"id {ident}: {a} {b} {c}")
+        print(f"{t_us / 1e6:12.6f} {fmt(a, b, c)}")
+
+
+if __name__ == "__main__":
+    main()
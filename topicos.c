@@ -0,0 +1,99 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: topicos.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Tópicos com seqlock e liberação dos assinantes.
+ *
+ *      As barreiras '__dmb()' ordenam o contador e os dados
+ *      também entre os dois núcleos (e impedem o compilador
+ *      de mover as cópias para fora do intervalo protegido).
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "topicos.h"
+#include "scheduler.h"
+
+typedef struct
+{
+    volatile uint32_t seq;           // Par = estável; ímpar = escrita em andamento
+    uint32_t assinantes;             // Bit i → tarefa i da tabela do escalonador (a cada mudança)
+    uint32_t assinantes_todas;       // Liberadas a cada publicação, mesmo sem mudança
+    uint8_t dados[TOPICO_MAX_BYTES] __attribute__((aligned(4)));
+} topico_t;
+
+static topico_t topicos[TOPICO_N];
+
+bool topico_publicar(topico_id_t id, const void *valor, size_t tamanho)
+{
+    assert(id < TOPICO_N && tamanho <= TOPICO_MAX_BYTES);
+    topico_t *t = &topicos[id];
+
+    uint32_t irq = save_and_disable_interrupts();
+    bool mudou = memcmp(t->dados, valor, tamanho) != 0;
+    uint32_t assinantes = t->assinantes_todas;
+    if (mudou)
+    {
+        t->seq++;
+        __dmb();
+        memcpy(t->dados, valor, tamanho);
+        __dmb();
+        t->seq++;
+        assinantes |= t->assinantes;
+    }
+    restore_interrupts(irq);
+
+    for (uint i = 0; assinantes; i++, assinantes >>= 1)
+    {
+        if (assinantes & 1u)
+            scheduler_release(i);
+    }
+    return mudou;
+}
+
+uint32_t topico_ler(topico_id_t id, void *valor, size_t tamanho)
+{
+    assert(id < TOPICO_N && tamanho <= TOPICO_MAX_BYTES);
+    const topico_t *t = &topicos[id];
+    uint32_t seq;
+
+    do
+    {
+        while ((seq = t->seq) & 1u)
+            tight_loop_contents(); // Escrita em andamento no outro núcleo
+        __dmb();
+        memcpy(valor, t->dados, tamanho);
+        __dmb();
+    } while (t->seq != seq);
+
+    return seq / 2;
+}
+
+uint32_t topico_versao(topico_id_t id)
+{
+    return topicos[id].seq / 2;
+}
+
+void topico_assinar(topico_id_t id, uint tarefa)
+{
+    assert(id < TOPICO_N && tarefa < SCHEDULER_MAX_TASKS);
+    uint32_t irq = save_and_disable_interrupts();
+    topicos[id].assinantes |= 1u << tarefa;
+    restore_interrupts(irq);
+}
+
+void topico_assinar_todas(topico_id_t id, uint tarefa)
+{
+    assert(id < TOPICO_N && tarefa < SCHEDULER_MAX_TASKS);
+    uint32_t irq = save_and_disable_interrupts();
+    topicos[id].assinantes_todas |= 1u << tarefa;
+    restore_interrupts(irq);
+}
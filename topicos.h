@@ -0,0 +1,101 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: topicos.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Troca de dados entre tarefas por tópicos
+ *      (publicação/assinatura).
+ *
+ *      Cada tópico guarda o último valor publicado atrás de
+ *      um seqlock: o publicador incrementa a sequência (ímpar
+ *      = escrita em andamento), copia o valor e incrementa de
+ *      novo; o leitor repete a cópia até obter a mesma
+ *      sequência par antes e depois. O publicador nunca
+ *      espera e o leitor sempre recebe um valor inteiro,
+ *      mesmo que a publicação venha de uma interrupção ou do
+ *      outro núcleo (um publicador por tópico).
+ *
+ *      A escrita ocorre com as interrupções do núcleo
+ *      desabilitadas, de modo que um leitor em interrupção
+ *      nunca encontra uma escrita do próprio núcleo pela
+ *      metade.
+ *
+ *      Uma publicação idêntica ao valor corrente (comparação
+ *      byte a byte) é ignorada. As demais liberam, por
+ *      'scheduler_release()', as tarefas assinantes do tópico:
+ *      os consumidores só acordam quando o dado muda. Quem
+ *      trata o tópico como série temporal (uma amostra por
+ *      publicação, valores repetidos inclusive) assina com
+ *      'topico_assinar_todas()'. Como o escalonador não é
+ *      multinúcleo, publicações em tópicos com assinantes devem
+ *      ocorrer no núcleo 0.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef TOPICOS_H
+#define TOPICOS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+// Maior valor de tópico, em bytes
+#define TOPICO_MAX_BYTES 16
+
+typedef enum
+{
+    TOPICO_TEMPERATURA, // float: média da última janela da Tarefa 1 (°C)
+    TOPICO_TENDENCIA,   // tendencia_info_t: classificação e inclinação da Tarefa 3
+    TOPICO_ALERTA,      // bool: estado do monitor de limiares da Tarefa 1
+    TOPICO_N
+} topico_id_t;
+
+/**
+ * @brief Publica um novo valor; libera os assinantes se ele mudou (e os de todas as publicações sempre).
+ *
+ * @param id Tópico
+ * @param valor Valor a copiar
+ * @param tamanho Tamanho do valor (até TOPICO_MAX_BYTES, o mesmo em todas as chamadas)
+ * @return true se o valor mudou
+ */
+bool topico_publicar(topico_id_t id, const void *valor, size_t tamanho);
+
+/**
+ * @brief Copia o valor corrente de forma consistente.
+ *
+ * Antes da primeira publicação o valor é todo zero.
+ *
+ * @param id Tópico
+ * @param valor Destino
+ * @param tamanho Tamanho do valor
+ * @return uint32_t Versão do valor (número de publicações que o alteraram)
+ */
+uint32_t topico_ler(topico_id_t id, void *valor, size_t tamanho);
+
+/**
+ * @brief Versão corrente do tópico, sem copiar o valor.
+ */
+uint32_t topico_versao(topico_id_t id);
+
+/**
+ * @brief Faz a tarefa ser liberada a cada mudança do tópico.
+ *
+ * @param id Tópico
+ * @param tarefa Índice da tarefa na tabela do escalonador
+ */
+void topico_assinar(topico_id_t id, uint tarefa);
+
+/**
+ * @brief Faz a tarefa ser liberada a cada publicação do tópico, mesmo sem mudança.
+ *
+ * @param id Tópico
+ * @param tarefa Índice da tarefa na tabela do escalonador
+ */
+void topico_assinar_todas(topico_id_t id, uint tarefa);
+
+#endif // TOPICOS_H